@@ -22,6 +22,29 @@ struct FMapReadyMessage
     FIntPoint Size = FIntPoint::ZeroValue;
 };
 
+/** Payload sent while the map is generated asynchronously (see UMapGrid2DComponent::bGenerateAsync). */
+USTRUCT(BlueprintType)
+struct FMapGenerationProgressMessage
+{
+    GENERATED_BODY()
+
+    /** Component that owns the map. */
+    UPROPERTY(BlueprintReadOnly)
+    TObjectPtr<UMapGrid2DComponent> Source = nullptr;
+
+    /** Generation steps finished so far. */
+    UPROPERTY(BlueprintReadOnly)
+    int32 StepsDone = 0;
+
+    /** Total generation steps. */
+    UPROPERTY(BlueprintReadOnly)
+    int32 NumSteps = 0;
+
+    /** Name of the step that just finished (empty before the first one). */
+    UPROPERTY(BlueprintReadOnly)
+    FString LastStepName;
+};
+
 /** Payload for reporting updated cells (e.g., object damaged/removed). */
 USTRUCT(BlueprintType)
 struct FMapCellsUpdatedMessage
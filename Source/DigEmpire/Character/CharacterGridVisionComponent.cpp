@@ -116,56 +116,49 @@ void UCharacterGridVisionComponent::DoVisionTick()
 
     const int32 R2 = R * R;
 
-    TArray<FGridCellWithCoord> NewlySeen;
+    // Mark the whole disc viewed in one word-packed pass; newly seen cells come from the bit difference
+    TArray<FIntPoint> NewlySeenCoords;
+    if (UMapGrid2D* Map = MapComponent->GetMap())
+    {
+        Map->MarkDiscViewed(Payload.Center, R, NewlySeenCoords);
+    }
 
-    for (int32 y = MinY; y <= MaxY; ++y)
+    // Square bounds are clipped to the map once by the visitor
+    if (const UMapGrid2D* Map = MapComponent->GetMap())
     {
-        for (int32 x = MinX; x <= MaxX; ++x)
+        Map->ForEachCellInRect<EMapCellField::All>(FIntRect(MinX, MinY, MaxX + 1, MaxY + 1), [&](const FMapCellView& V)
         {
-            const int32 dx = x - CenterX;
-            const int32 dy = y - CenterY;
-            if (dx*dx + dy*dy > R2) continue; // outside circle
-            if (!MapComponent->IsInBounds(x, y)) continue;
-
-            bool bWasViewed = false;
-            if (UMapGrid2D* Map = MapComponent->GetMap())
-            {
-                FMapCell Tmp;
-                if (Map->GetCell(x, y, Tmp))
-                {
-                    bWasViewed = Tmp.bVieved;
-                }
-                Map->SetViewedAt(x, y, true);
-            }
-
-            FGridCellWithCoord Entry;
-            Entry.Coord = FIntPoint(x, y);
-            MapComponent->GetCell(x, y, Entry.Cell); // if fails, leaves default cell
-
+            const int32 dx = V.X - CenterX;
+            const int32 dy = V.Y - CenterY;
             const int32 d2 = dx*dx + dy*dy;
+            if (d2 > R2) return; // outside circle
+
             int32 RingIndex = 0;
             if (d2 > 0)
             {
                 RingIndex = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(d2)));
                 RingIndex = FMath::Clamp(RingIndex, 0, R);
             }
-            Payload.RadiusLayers[RingIndex].Cells.Add(Entry);
-
-            if (!bWasViewed)
-            {
-                NewlySeen.Add(Entry);
-            }
-        }
+            FGridCellWithCoord& Entry = Payload.RadiusLayers[RingIndex].Cells.AddDefaulted_GetRef();
+            Entry.Coord = FIntPoint(V.X, V.Y);
+            Map->ToMapCell(V, Entry.Cell);
+        });
     }
 
     // Publish vision before luminance so renderer can build instances first
     UGameplayMessageSubsystem::Get(this).BroadcastMessage(VisionChannel, Payload);
 
-    if (FirstSeenChannel.IsValid() && NewlySeen.Num() > 0)
+    if (FirstSeenChannel.IsValid() && NewlySeenCoords.Num() > 0)
     {
         FCellsFirstSeenMessage First;
         First.SourceActor = GetOwner();
-        First.Cells = MoveTemp(NewlySeen);
+        First.Cells.Reserve(NewlySeenCoords.Num());
+        for (const FIntPoint& C : NewlySeenCoords)
+        {
+            FGridCellWithCoord& Entry = First.Cells.AddDefaulted_GetRef();
+            Entry.Coord = C;
+            MapComponent->GetCell(C.X, C.Y, Entry.Cell);
+        }
         UGameplayMessageSubsystem::Get(this).BroadcastMessage(FirstSeenChannel, First);
     }
 
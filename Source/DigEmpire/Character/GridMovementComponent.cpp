@@ -213,21 +213,8 @@ bool UGridMovementComponent::IsWorldPositionValid(const FVector& WorldPos) const
 
 bool UGridMovementComponent::IsCellBlocked(int32 GX, int32 GY) const
 {
-    FMapCell Cell;
-    if (MapComponent->GetCell(GX, GY, Cell))
-    {
-        if (Cell.Occupant)
-        {
-            return Cell.Occupant->IsBlocked();
-        }
-    }
-
-	FGameplayTag Obj; int32 Durability = 0;
-	if (!MapComponent->GetObjectAt(GX, GY, Obj, Durability))
-	{
-		return false;
-	}
-	return (Durability > 0 && Obj.IsValid());
+    // One bit: the grid keeps occupant blocking and objects folded into a walkability plane
+	return MapComponent->IsBlockedAt(GX, GY);
 }
 
 bool UGridMovementComponent::InBounds(int32 GX, int32 GY) const
@@ -307,19 +294,19 @@ void UGridMovementComponent::MoveToFirstFreeCell()
     const FIntPoint Size = MapComponent->GetSize();
     // Prefer random free cell within zone(s) with depth == 0
     TArray<FIntPoint> Candidates;
-    if (UMapGrid2D* Map = MapComponent->GetMap())
+    if (const UMapGrid2D* Map = MapComponent->GetMap())
     {
-        for (int32 y = 0; y < Size.Y; ++y)
+        // Free cells (no object, no actor) of every depth-0 zone, straight from the zone free lists
+        TArray<int32> FreeIndices;
+        for (int32 ZoneId = 0; ZoneId < Map->GetNumZones(); ++ZoneId)
         {
-            for (int32 x = 0; x < Size.X; ++x)
-            {
-                if (IsCellBlocked(x, y)) continue;
-                const int32 zoneId = Map->GetZoneAt(x, y);
-                if (MapComponent->GetZoneDepth(zoneId) == 0)
-                {
-                    Candidates.Add(FIntPoint(x, y));
-                }
-            }
+            if (MapComponent->GetZoneDepth(ZoneId) != 0) continue;
+            Map->GetFreeCellIndicesInZone(ZoneId, FreeIndices);
+        }
+        Candidates.Reserve(FreeIndices.Num());
+        for (const int32 id : FreeIndices)
+        {
+            Candidates.Add(Map->IndexToCell(id));
         }
     }
     if (Candidates.Num() == 0)
@@ -7,7 +7,6 @@
 #include "EngineUtils.h"
 #include "GameFramework/GameModeBase.h"
 #include "DigEmpire/Map/MapGrid2DComponent.h"
-#include "DigEmpire/Map/MapSpriteRenderer.h"
 
 void UDECheatManager::Cheat_SetVisionRadiusCells(int32 NewRadius)
 {
@@ -84,19 +83,8 @@ void UDECheatManager::Cheat_NextCaveGenerationStep()
     }
     if (!MapComp) return;
 
-    // Execute next generation step
+    // Execute next generation step; its cell changes reach renderers through the cells-updated broadcast
     MapComp->ExecuteNextGenerationStep();
-
-    // Force redraw using any AMapSpriteRenderer on level
-    AMapSpriteRenderer* Renderer = nullptr;
-    for (TActorIterator<AMapSpriteRenderer> It(World); It; ++It)
-    {
-        Renderer = *It; break;
-    }
-    if (Renderer)
-    {
-        Renderer->RebuildAllFromMap(MapComp);
-    }
 }
 
 void UDECheatManager::Cheat_SetMaxVisibility(bool bEnable)
@@ -0,0 +1,337 @@
+#include "DigEmpireGenerateMapsCommandlet.h"
+
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "DigEmpire/Map/MapGrid2DComponent.h"
+#include "DigEmpire/Map/Generation/MapGenerationStepDataBase.h"
+#include "DigEmpire/Map/Generation/MapGenerationPipeline.h"
+#include "DigEmpire/Map/Generation/MapGenerationReport.h"
+#include "Async/ParallelFor.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "HAL/FileManager.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UDigEmpireGenerateMapsCommandlet::UDigEmpireGenerateMapsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UDigEmpireGenerateMapsCommandlet::Main(const FString& Params)
+{
+    // Configuration: the component on the given actor class
+    FString ActorPath;
+    if (!FParse::Value(*Params, TEXT("Actor="), ActorPath))
+    {
+        UE_LOG(LogDigEmpireMapGen, Error, TEXT("Missing -Actor=<class path of an actor with a MapGrid2DComponent>"));
+        return 1;
+    }
+    UClass* ActorClass = LoadClass<AActor>(nullptr, *ActorPath);
+    if (!ActorClass && !ActorPath.EndsWith(TEXT("_C")))
+    {
+        ActorClass = LoadClass<AActor>(nullptr, *(ActorPath + TEXT("_C")));
+    }
+    const UMapGrid2DComponent* Config = ActorClass ? FindComponentTemplate(ActorClass) : nullptr;
+    if (!Config)
+    {
+        UE_LOG(LogDigEmpireMapGen, Error, TEXT("No MapGrid2DComponent found on %s"), *ActorPath);
+        return 1;
+    }
+
+    TArray<FIntPoint> Sizes;
+    FString SizesStr;
+    if (FParse::Value(*Params, TEXT("Sizes="), SizesStr, /*bShouldStopOnSeparator*/ false))
+    {
+        TArray<FString> Parts;
+        SizesStr.ParseIntoArray(Parts, TEXT(","), true);
+        for (const FString& Part : Parts)
+        {
+            const int32 S = FCString::Atoi(*Part);
+            if (S > 0) Sizes.Add(FIntPoint(S, S));
+        }
+    }
+    if (Sizes.Num() == 0)
+    {
+        Sizes.Add(FIntPoint(FMath::Max(1, Config->MapSizeX), FMath::Max(1, Config->MapSizeY)));
+    }
+
+    int32 NumSeeds = 8, FirstSeed = 1;
+    int32 Parallel = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    FParse::Value(*Params, TEXT("Seeds="), NumSeeds);
+    FParse::Value(*Params, TEXT("FirstSeed="), FirstSeed);
+    FParse::Value(*Params, TEXT("Parallel="), Parallel);
+    NumSeeds = FMath::Max(1, NumSeeds);
+    Parallel = FMath::Max(1, Parallel);
+    const bool bPng = FParse::Param(*Params, TEXT("Png"));
+
+    FString OutDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MapGenBatch"));
+    FParse::Value(*Params, TEXT("Out="), OutDir);
+    IFileManager::Get().MakeDirectory(*OutDir, /*Tree*/ true);
+    const FString StepsCsvPath = FPaths::Combine(OutDir, TEXT("steps.csv"));
+    IFileManager::Get().Delete(*StepsCsvPath);
+
+    for (const UMapGenerationStepDataBase* Step : Config->GenerationSteps)
+    {
+        if (Step && Step->RequiresGameThread())
+        {
+            UE_LOG(LogDigEmpireMapGen, Display, TEXT("Headless run: %s and the steps after it need a world and are skipped"), *Step->GetName());
+            break;
+        }
+    }
+
+    struct FJob
+    {
+        FIntPoint Size;
+        int32 Seed = 0;
+        UMapGrid2D* Map = nullptr;
+        TSharedPtr<FMapGenerationPipeline> Pipeline;
+        FMapCheck Check;
+        TArray<FColor> Pixels;
+    };
+    TArray<FJob> Jobs;
+    for (const FIntPoint& Size : Sizes)
+    {
+        for (int32 s = 0; s < NumSeeds; ++s)
+        {
+            FJob& Job = Jobs.AddDefaulted_GetRef();
+            Job.Size = Size;
+            Job.Seed = FirstSeed + s;
+        }
+    }
+
+    FString MapsCsv = TEXT("SizeX,SizeY,Seed,Valid,Zones,UnlabeledCells,DisconnectedZones,Rooms,Passages,OpenPct,WorkerMs,ArenaKB\n");
+    int32 NumValid = 0;
+    int64 TotalCells = 0;
+    const double RunStart = FPlatformTime::Seconds();
+
+    for (int32 First = 0; First < Jobs.Num(); First += Parallel)
+    {
+        const int32 Last = FMath::Min(Jobs.Num(), First + Parallel);
+
+        // Game thread: private maps, seeded step copies and one worker pipeline per map
+        for (int32 i = First; i < Last; ++i)
+        {
+            FJob& Job = Jobs[i];
+            Job.Map = NewObject<UMapGrid2D>(GetTransientPackage());
+            BatchObjects.Add(Job.Map);
+            Job.Map->Initialize(Job.Size.X, Job.Size.Y, Config->bUseChunkedStorage);
+            Job.Map->SetChangeJournalEnabled(false);
+            Job.Map->FillBackground(Config->DefaultBackgroundTag);
+
+            Job.Pipeline = MakeShared<FMapGenerationPipeline>(Job.Map, MakeSeededSteps(Config->GenerationSteps, Job.Seed));
+            Job.Pipeline->Launch();
+        }
+        for (int32 i = First; i < Last; ++i)
+        {
+            Jobs[i].Pipeline->Wait();
+        }
+
+        // Validation and rendering only read the finished maps
+        ParallelFor(Last - First, [&](int32 k)
+        {
+            FJob& Job = Jobs[First + k];
+            Job.Check = CheckMap(Job.Map, Job.Pipeline->GetContext().GetZoneLabels());
+            if (bPng) RenderMap(Job.Map, Job.Pixels);
+        });
+
+        // Game thread: results, then release the batch
+        for (int32 i = First; i < Last; ++i)
+        {
+            FJob& Job = Jobs[i];
+            // Steps may overlap and maps run side by side: time the whole pipeline and take memory
+            // from the map's own arena, not from summed step times or process-wide deltas
+            FMapGenReport Report;
+            Report.MapSize = Job.Size;
+            Report.TotalSeconds = Job.Pipeline->GetWorkerSeconds();
+            for (const FMapGenStepReport& StepReport : Job.Pipeline->GetStepReports())
+            {
+                if (!StepReport.StepName.IsEmpty()) Report.Steps.Add(StepReport);
+            }
+            Report.AppendToCsv(StepsCsvPath);
+            const int64 ArenaBytes = Job.Pipeline->GetContext().GetScratch().GetReservedBytes();
+
+            const FMapCheck& C = Job.Check;
+            MapsCsv += FString::Printf(TEXT("%d,%d,%d,%d,%d,%lld,%d,%d,%d,%.2f,%.3f,%lld\n"),
+                Job.Size.X, Job.Size.Y, Job.Seed, C.IsValid() ? 1 : 0, C.NumZones, C.UnlabeledCells,
+                C.DisconnectedZones, C.Rooms, C.Passages, C.OpenFraction * 100.0, Report.TotalSeconds * 1000.0, ArenaBytes / 1024);
+            if (C.IsValid())
+            {
+                ++NumValid;
+            }
+            else
+            {
+                UE_LOG(LogDigEmpireMapGen, Warning, TEXT("%dx%d seed %d invalid: %lld unlabeled cells, %d disconnected zones"),
+                    Job.Size.X, Job.Size.Y, Job.Seed, C.UnlabeledCells, C.DisconnectedZones);
+            }
+            TotalCells += int64(Job.Size.X) * Job.Size.Y;
+
+            if (bPng && Job.Pixels.Num() > 0)
+            {
+                const FString PngPath = FPaths::Combine(OutDir, FString::Printf(TEXT("map_%dx%d_seed%d.png"), Job.Size.X, Job.Size.Y, Job.Seed));
+                FImageUtils::SaveImageByExtension(*PngPath, FImageView(Job.Pixels.GetData(), Job.Size.X, Job.Size.Y));
+            }
+
+            Job.Pipeline.Reset();
+            Job.Map = nullptr;
+            Job.Pixels.Empty();
+        }
+        BatchObjects.Reset();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    const double RunSeconds = FPlatformTime::Seconds() - RunStart;
+    FFileHelper::SaveStringToFile(MapsCsv, *FPaths::Combine(OutDir, TEXT("maps.csv")));
+
+    UE_LOG(LogDigEmpireMapGen, Display, TEXT("Generated %d maps (%d valid) in %.2f s: %.2f maps/s, %.2f Mcells/s. Results in %s"),
+        Jobs.Num(), NumValid, RunSeconds, Jobs.Num() / FMath::Max(RunSeconds, 1e-6),
+        TotalCells / 1e6 / FMath::Max(RunSeconds, 1e-6), *OutDir);
+
+    return NumValid == Jobs.Num() ? 0 : 1;
+}
+
+const UMapGrid2DComponent* UDigEmpireGenerateMapsCommandlet::FindComponentTemplate(UClass* ActorClass)
+{
+    // Native components live on the CDO, Blueprint-added ones on the construction script; a child
+    // Blueprint that edits an inherited one keeps its version in its inheritable component handler
+    if (const AActor* CDO = ActorClass->GetDefaultObject<AActor>())
+    {
+        if (const UMapGrid2DComponent* Comp = CDO->FindComponentByClass<UMapGrid2DComponent>())
+        {
+            return Comp;
+        }
+    }
+    for (UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(ActorClass); BPClass;
+         BPClass = Cast<UBlueprintGeneratedClass>(BPClass->GetSuperClass()))
+    {
+        if (!BPClass->SimpleConstructionScript) continue;
+        for (const USCS_Node* Node : BPClass->SimpleConstructionScript->GetAllNodes())
+        {
+            const UMapGrid2DComponent* Comp = Cast<UMapGrid2DComponent>(Node->ComponentTemplate);
+            if (!Comp) continue;
+
+            // Nearest override wins, from the requested class up to the one that added the component
+            const FComponentKey Key(Node);
+            for (UBlueprintGeneratedClass* Child = Cast<UBlueprintGeneratedClass>(ActorClass); Child && Child != BPClass;
+                 Child = Cast<UBlueprintGeneratedClass>(Child->GetSuperClass()))
+            {
+                const UInheritableComponentHandler* Handler = Child->GetInheritableComponentHandler();
+                if (const UMapGrid2DComponent* Override = Handler ? Cast<UMapGrid2DComponent>(Handler->GetOverridenComponentTemplate(Key)) : nullptr)
+                {
+                    return Override;
+                }
+            }
+            return Comp;
+        }
+    }
+    return nullptr;
+}
+
+TArray<const UMapGenerationStepDataBase*> UDigEmpireGenerateMapsCommandlet::MakeSeededSteps(
+    const TArray<TObjectPtr<UMapGenerationStepDataBase>>& Steps, int32 Seed)
+{
+    TArray<const UMapGenerationStepDataBase*> Out;
+    for (int32 i = 0; i < Steps.Num(); ++i)
+    {
+        const UMapGenerationStepDataBase* Step = Steps[i];
+        if (!Step) continue;
+
+        // Settings assets are shared; each map gets its own copy with a fixed, step-specific seed
+        UMapGenerationStepDataBase* Copy = DuplicateObject(Step, GetTransientPackage());
+        BatchObjects.Add(Copy);
+        if (FIntProperty* SeedProp = FindFProperty<FIntProperty>(Copy->GetClass(), TEXT("RandomSeed")))
+        {
+            SeedProp->SetPropertyValue_InContainer(Copy, int32(HashCombine(GetTypeHash(Seed), GetTypeHash(i)) & 0x7fffffff));
+        }
+        Out.Add(Copy);
+    }
+    return Out;
+}
+
+UDigEmpireGenerateMapsCommandlet::FMapCheck UDigEmpireGenerateMapsCommandlet::CheckMap(const UMapGrid2D* Map, const TArray<int32>& ZoneLabels)
+{
+    FMapCheck C;
+    const FIntPoint Size = Map->GetSize();
+    const int32 W = Size.X, H = Size.Y;
+    const int32 N = W * H;
+    C.Rooms = Map->GetRooms().Num();
+    C.Passages = Map->GetPassages().Num();
+    if (ZoneLabels.Num() != N)
+    {
+        C.UnlabeledCells = N; // no zone step ran
+        return C;
+    }
+
+    int32 MaxZone = -1;
+    for (int32 v : ZoneLabels)
+    {
+        if (v < 0) ++C.UnlabeledCells;
+        else MaxZone = FMath::Max(MaxZone, v);
+    }
+    C.NumZones = MaxZone + 1;
+
+    // Open (object-free) components per zone, 4-connected
+    const TMapGridPlane<int32>& Durability = Map->GetDurabilityPlane();
+    TArray<int32> ComponentsPerZone; ComponentsPerZone.Init(0, C.NumZones);
+    TBitArray<> Visited(false, N);
+    TArray<int32> Stack;
+    int64 Open = 0;
+    for (int32 id = 0; id < N; ++id)
+    {
+        const int32 z = ZoneLabels[id];
+        if (z < 0 || Visited[id] || Durability[id] > 0) continue;
+
+        ++ComponentsPerZone[z];
+        Visited[id] = true;
+        Stack.Reset(); Stack.Add(id);
+        while (!Stack.IsEmpty())
+        {
+            const int32 n = Stack.Pop(EAllowShrinking::No);
+            ++Open;
+            const int32 x = n % W, y = n / W;
+            auto Push = [&](int32 nid)
+            {
+                if (ZoneLabels[nid] != z || Visited[nid] || Durability[nid] > 0) return;
+                Visited[nid] = true;
+                Stack.Add(nid);
+            };
+            if (x > 0)     Push(n - 1);
+            if (x < W - 1) Push(n + 1);
+            if (y > 0)     Push(n - W);
+            if (y < H - 1) Push(n + W);
+        }
+    }
+    for (int32 Count : ComponentsPerZone)
+    {
+        if (Count > 1) ++C.DisconnectedZones;
+    }
+    C.OpenFraction = N > 0 ? double(Open) / N : 0.0;
+    return C;
+}
+
+void UDigEmpireGenerateMapsCommandlet::RenderMap(const UMapGrid2D* Map, TArray<FColor>& OutPixels)
+{
+    const FIntPoint Size = Map->GetSize();
+    OutPixels.SetNumUninitialized(Size.X * Size.Y);
+
+    // Zone hue (same palette as the generators' debug draw); walls darker, ore bright
+    constexpr uint32 Fields = EMapCellField::Durability | EMapCellField::Ore | EMapCellField::Zone;
+    Map->ForEachCellInRect<Fields>(FIntRect(0, 0, Size.X, Size.Y), [&](const FMapCellView& V)
+    {
+        FColor& P = OutPixels[V.X + V.Y * Size.X];
+        if (V.OreId != 0)
+        {
+            P = FLinearColor::MakeFromHSV8(uint8((V.OreId * 83) & 0xFF), 255, 255).ToFColor(true);
+            return;
+        }
+        const uint8 Hue = V.ZoneId >= 0 ? uint8((V.ZoneId * 47) & 0xFF) : 0;
+        const uint8 Sat = V.ZoneId >= 0 ? 160 : 0;
+        P = FLinearColor::MakeFromHSV8(Hue, Sat, V.HasObject() ? 70 : 220).ToFColor(true);
+    });
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DigEmpireGenerateMapsCommandlet.generated.h"
+
+class UMapGrid2DComponent;
+class UMapGenerationStepDataBase;
+
+/**
+ * Headless batch map generation for throughput runs and seed validation (no world, no GPU).
+ *
+ * Takes the generation setup of the UMapGrid2DComponent on an actor class and builds every
+ * size x seed combination, several maps at a time, each through the regular worker pipeline.
+ * Steps that RequiresGameThread (actor placers) and everything after them are skipped.
+ *
+ * UnrealEditor-Cmd DigEmpire.uproject -run=DigEmpireGenerateMaps
+ *     -Actor=/Game/Map/BP_MapGrid.BP_MapGrid_C   actor class owning the component (required)
+ *     -Sizes=64,256,1024,4096                    square map sizes (default: the component's size)
+ *     -Seeds=16 -FirstSeed=1                     seeds per size (each step gets its own derived seed)
+ *     -Parallel=8                                maps in flight at once (default: logical cores)
+ *     -Png                                       write a PNG of every map
+ *     -Out=<dir>                                 output folder (default Saved/MapGenBatch)
+ *
+ * Writes maps.csv (timing and validity per map) and steps.csv (per-step report) to the output folder.
+ */
+UCLASS()
+class UDigEmpireGenerateMapsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+public:
+    UDigEmpireGenerateMapsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Validity statistics of one generated map. */
+    struct FMapCheck
+    {
+        int32 NumZones = 0;
+        int64 UnlabeledCells = 0;
+        int32 DisconnectedZones = 0;   // zones whose open cells form more than one component
+        int32 Rooms = 0;
+        int32 Passages = 0;
+        double OpenFraction = 0.0;
+
+        bool IsValid() const { return UnlabeledCells == 0 && DisconnectedZones == 0; }
+    };
+
+    static const UMapGrid2DComponent* FindComponentTemplate(UClass* ActorClass);
+
+    /** Per-map copies of the steps with RandomSeed derived from Seed. */
+    TArray<const UMapGenerationStepDataBase*> MakeSeededSteps(const TArray<TObjectPtr<UMapGenerationStepDataBase>>& Steps, int32 Seed);
+
+    static FMapCheck CheckMap(const class UMapGrid2D* Map, const TArray<int32>& ZoneLabels);
+    static void RenderMap(const class UMapGrid2D* Map, TArray<FColor>& OutPixels);
+
+    /** Maps and step copies of the batch in flight (kept from GC until the batch is written out) */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UObject>> BatchObjects;
+};
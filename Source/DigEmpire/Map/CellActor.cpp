@@ -4,6 +4,7 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 
 #include "DigEmpire/BusEvents/CharacterGridVisionMessages.h"
+#include "DigEmpire/Map/MapGrid2D.h"
 #include "DigEmpire/Tags/DENativeTags.h"
 
 ACellActor::ACellActor()
@@ -48,9 +49,43 @@ void ACellActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
     {
         UGameplayMessageSubsystem::Get(this).UnregisterListener(VisionHandle);
     }
+
+    // Leave the grid so its blocked/free state does not keep pointing at a dead actor
+    if (UMapGrid2D* Grid = OwningGrid.Get())
+    {
+        if (Grid->GetActorAt(GridCell.X, GridCell.Y) == this)
+        {
+            Grid->SetActorAt(GridCell.X, GridCell.Y, nullptr);
+        }
+    }
+    OwningGrid.Reset();
+
     Super::EndPlay(EndPlayReason);
 }
 
+void ACellActor::SetGridCell(UMapGrid2D* InGrid, const FIntPoint& InCell)
+{
+    OwningGrid = InGrid;
+    GridCell = InCell;
+}
+
+void ACellActor::ClearGridCell(const UMapGrid2D* InGrid)
+{
+    if (OwningGrid.Get() == InGrid)
+    {
+        OwningGrid.Reset();
+        GridCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+    }
+}
+
+void ACellActor::NotifyBlockingChanged()
+{
+    if (UMapGrid2D* Grid = OwningGrid.Get())
+    {
+        Grid->RefreshBlockedAt(GridCell.X, GridCell.Y);
+    }
+}
+
 void ACellActor::HandleVisionMessage(const FCellsFirstSeenMessage& Msg)
 {
     // Determine this actor's grid coordinate by world position
@@ -8,6 +8,8 @@
 #include "DigEmpire/Config/DEConstants.h"
 #include "CellActor.generated.h"
 
+class UMapGrid2D;
+
 /**
  * Base actor that can be placed on a map cell.
  * Override IsBlocked() to control cell accessibility.
@@ -20,10 +22,26 @@ class ACellActor : public AActor
 public:
     ACellActor();
 
-    /** Returns true if this actor blocks movement on its cell. */
+    /** Returns true if this actor blocks movement on its cell. Call NotifyBlockingChanged when the result changes. */
     UFUNCTION(BlueprintCallable, Category="CellActor")
     virtual bool IsBlocked() const { return false; }
 
+    /** Called by the grid when this actor is placed on a cell. */
+    void SetGridCell(UMapGrid2D* InGrid, const FIntPoint& InCell);
+
+    /** Called by the grid when this actor is replaced on its cell. */
+    void ClearGridCell(const UMapGrid2D* InGrid);
+
+    /** Grid cell this actor occupies (INDEX_NONE coords if not placed). */
+    UFUNCTION(BlueprintPure, Category="CellActor")
+    FIntPoint GetGridCell() const { return GridCell; }
+
+    /**
+     * Save/load the actor's gameplay state for map save files. Called on a placed actor;
+     * subclasses append their own fields after calling Super.
+     */
+    virtual void SerializeCellState(FArchive& Ar) {}
+
     /** Called when the cell containing this actor becomes visible (first seen). */
     UFUNCTION(BlueprintNativeEvent, Category="CellActor|Events")
     void OnCellSeen();
@@ -49,7 +67,16 @@ protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+    /** Let the owning grid refresh this cell's blocked bit after IsBlocked() changed. */
+    void NotifyBlockingChanged();
+
 private:
+    /** Grid this actor was placed on via UMapGrid2D::SetActorAt */
+    TWeakObjectPtr<UMapGrid2D> OwningGrid;
+
+    /** Cell on OwningGrid */
+    FIntPoint GridCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
     /** Gameplay Message Subsystem listener for vision updates. */
     FGameplayMessageListenerHandle VisionHandle;
 
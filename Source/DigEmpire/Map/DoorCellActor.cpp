@@ -7,6 +7,7 @@ void ADoorCellActor::OpenDoor()
         return;
     }
     bIsOpen = true;
+    NotifyBlockingChanged();
     OnDoorOpened();
 }
 
@@ -15,3 +16,22 @@ void ADoorCellActor::SetDoorColor(const FGameplayTag& InColor)
     DoorColor = InColor;
     OnDoorColorAssigned(InColor);
 }
+
+void ADoorCellActor::SerializeCellState(FArchive& Ar)
+{
+    Super::SerializeCellState(Ar);
+
+    FName ColorName = DoorColor.GetTagName();
+    bool bOpen = bIsOpen;
+    Ar << ColorName;
+    Ar << bOpen;
+
+    if (Ar.IsLoading() && !Ar.IsError())
+    {
+        SetDoorColor(FGameplayTag::RequestGameplayTag(ColorName, /*ErrorIfNotFound*/ false));
+        if (bOpen)
+        {
+            OpenDoor();
+        }
+    }
+}
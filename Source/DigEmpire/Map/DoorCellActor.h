@@ -33,6 +33,8 @@ public:
 
     virtual bool IsBlocked() const override { return !bIsOpen; }
 
+    virtual void SerializeCellState(FArchive& Ar) override;
+
     UFUNCTION(BlueprintNativeEvent, Category="Door|Events")
     void OnDoorOpened();
     virtual void OnDoorOpened_Implementation() {}
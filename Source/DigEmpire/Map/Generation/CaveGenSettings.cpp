@@ -1,13 +1,15 @@
 #include "CaveGenSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "CaveGenerator.h"
 // No longer depends on ZoneBorderSettings
 
-void UCaveGenSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void UCaveGenSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() <= 0) return;
+    if (!Context.HasZoneLabels()) return;
     UCaveGenerator* CaveGen = NewObject<UCaveGenerator>();
-    CaveGen->Generate(Map, InOutZoneLabels, this);
+    CaveGen->Generate(Context, this);
 }
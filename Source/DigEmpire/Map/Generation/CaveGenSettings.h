@@ -6,6 +6,16 @@
 #include "GameplayTagContainer.h"
 #include "CaveGenSettings.generated.h"
 
+/** Implementation used for the CA smoothing iterations (both give identical results). */
+UENUM(BlueprintType)
+enum class ECaveCAEngine : uint8
+{
+    /** One cell at a time */
+    Scalar,
+    /** 64 cells per word with bit-sliced neighbor counters */
+    BitParallel
+};
+
 /** Settings for per-zone cellular automata cave generation. */
 UCLASS(BlueprintType)
 class UCaveGenSettings : public UMapGenerationStepDataBase
@@ -28,6 +38,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cave|Rules", meta=(ClampMin="0", ClampMax="8"))
     int32 SurvivalLimit = 4;
 
+    /** CA kernel used for the smoothing iterations. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cave|Iter")
+    ECaveCAEngine Engine = ECaveCAEngine::BitParallel;
+
     /** Random seed; if < 0 a random seed is used. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Cave|Random")
     int32 RandomSeed = -1;
@@ -45,5 +59,8 @@ public:
     TArray<FGameplayTag> ImmutableObjectTags;
 
     // Execute step: run cave CA per zone
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Objects | EMapGenAccess::Passages | EMapGenAccess::Rooms; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::Objects; }
 };
@@ -1,87 +1,120 @@
 #include "CaveGenerator.h"
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "Async/ParallelFor.h"
+
+namespace CaveBits
+{
+    /** Bit-sliced counter: Acc[k] holds bit k of a per-cell count for 64 cells. */
+    static constexpr int32 NumPlanes = 5; // counts up to 31 (8 neighbors x weight 2 max = 16)
+
+    /** Add a one-bit input to every cell's counter (ripple carry across planes). */
+    FORCEINLINE void AddBit(uint64 (&Acc)[NumPlanes], uint64 In)
+    {
+        for (int32 k = 0; k < NumPlanes && In; ++k)
+        {
+            const uint64 Carry = Acc[k] & In;
+            Acc[k] ^= In;
+            In = Carry;
+        }
+    }
+
+    /** Add the 8-neighborhood of word W on row Y (rows padded so Y-1/Y+1 exist). */
+    FORCEINLINE void AddNeighbors(uint64 (&Acc)[NumPlanes], const uint64* Plane, int32 WordsPerRow, int32 Y, int32 W)
+    {
+        const uint64* Rows[3] = { Plane + (Y - 1) * WordsPerRow, Plane + Y * WordsPerRow, Plane + (Y + 1) * WordsPerRow };
+        for (int32 r = 0; r < 3; ++r)
+        {
+            const uint64* R = Rows[r];
+            // Bit x of West holds cell x-1, bit x of East holds cell x+1
+            const uint64 West = (R[W] << 1) | (W > 0 ? R[W - 1] >> 63 : 0);
+            const uint64 East = (R[W] >> 1) | (W + 1 < WordsPerRow ? R[W + 1] << 63 : 0);
+            AddBit(Acc, West);
+            AddBit(Acc, East);
+            if (r != 1) AddBit(Acc, R[W]);
+        }
+    }
+
+    /** Cells whose count is >= Limit. */
+    FORCEINLINE uint64 GreaterEqual(const uint64 (&Acc)[NumPlanes], int32 Limit)
+    {
+        uint64 Gt = 0, Eq = ~uint64(0);
+        for (int32 k = NumPlanes - 1; k >= 0; --k)
+        {
+            if ((Limit >> k) & 1)
+            {
+                Eq &= Acc[k];
+            }
+            else
+            {
+                Gt |= Eq & Acc[k];
+                Eq &= ~Acc[k];
+            }
+        }
+        return Gt | Eq;
+    }
+}
 
 bool UCaveGenerator::Generate(UMapGrid2D* MapGrid,
                               const TArray<int32>& ZoneLabels,
                               const UCaveGenSettings* Settings)
 {
+    FMapGenerationContext Context(MapGrid, /*World*/ nullptr);
+    Context.SetZoneLabels(CopyTemp(ZoneLabels));
+    return Generate(Context, Settings);
+}
+
+bool UCaveGenerator::Generate(FMapGenerationContext& Context, const UCaveGenSettings* Settings)
+{
+    UMapGrid2D* MapGrid = Context.GetMap();
     if (!MapGrid || !Settings) return false;
     const FIntPoint Size = MapGrid->GetSize();
     const int32 W = Size.X, H = Size.Y;
     if (W <= 0 || H <= 0) return false;
+    const TArray<int32>& ZoneLabels = Context.GetZoneLabels();
     if (ZoneLabels.Num() != W * H) return false;
 
-    FRandomStream RNG(Settings->RandomSeed);
-    if (Settings->RandomSeed < 0) RNG.GenerateNewSeed();
+    // Zones in parallel, one stream each (see MapGenZones)
+    const uint32 BaseSeed = MapGenZones::MakeBaseSeed(Settings->RandomSeed);
+    const TConstArrayView<FIntRect> ZoneBounds = Context.GetZoneBounds();
+    const int32 NumZones = ZoneBounds.Num();
+    if (NumZones <= 0) return true;
 
-    // Determine max zone id
-    int32 MaxZoneId = 0; for (int v : ZoneLabels) if (v > MaxZoneId) MaxZoneId = v;
+    TArray<FZoneCA> Zones;
+    Zones.SetNum(NumZones);
+    for (int32 z = 0; z < NumZones; ++z) Zones[z].Box = ZoneBounds[z];
 
-    TArray<int8> FixedState; FixedState.SetNum(W * H);
-    TArray<uint8> Cur; Cur.SetNumZeroed(W * H);
-    TArray<uint8> Nxt; Nxt.SetNumZeroed(W * H);
-
-    for (int32 ZoneId = 0; ZoneId <= MaxZoneId; ++ZoneId)
+    // Shared read-only inputs: immutable tag ids and passage cells (immutable empty in every zone)
+    ImmutableMask = MapGrid->MakeTagMask(Settings->ImmutableObjectTags);
+    TBitArray<> PassageCells(false, W * H);
+    for (const FZonePassage& P : MapGrid->GetPassages())
     {
-        // Build masks and initial state for this zone
-        BuildZoneMasks(MapGrid, ZoneLabels, ZoneId, Settings, FixedState, Cur);
-
-        // Randomize mutable cells using FillChance
-        for (int32 y = 0; y < H; ++y)
+        for (const FIntPoint& C : P.Cells)
         {
-            for (int32 x = 0; x < W; ++x)
-            {
-                const int32 id = Idx(x, y, W);
-                if (ZoneLabels[id] != ZoneId) continue;
-                if (FixedState[id] == -1)
-                {
-                    Cur[id] = (RNG.FRand() < Settings->FillChance) ? 1 : 0;
-                }
-                else
-                {
-                    Cur[id] = (FixedState[id] == 1) ? 1 : 0;
-                }
-            }
+            if (MapGrid->IsInBounds(C.X, C.Y)) PassageCells[Idx(C.X, C.Y, W)] = true;
         }
+    }
 
-        // Iterations
-        for (int iter = 0; iter < Settings->Iterations; ++iter)
-        {
-            for (int32 y = 0; y < H; ++y)
-            for (int32 x = 0; x < W; ++x)
-            {
-                const int32 id = Idx(x, y, W);
-                if (ZoneLabels[id] != ZoneId) continue;
-
-                if (FixedState[id] != -1)
-                {
-                    Nxt[id] = (FixedState[id] == 1) ? 1 : 0; // immutable
-                    continue;
-                }
-
-                const int n = CountNeighbors8(FixedState, Cur, ZoneLabels, ZoneId, x, y, W, H);
-                if (Cur[id] == 1)
-                {
-                    Nxt[id] = (n >= Settings->SurvivalLimit) ? 1 : 0;
-                }
-                else
-                {
-                    Nxt[id] = (n >= Settings->BirthLimit) ? 1 : 0;
-                }
-            }
-            // swap buffers
-            Swap(Cur, Nxt);
-        }
+    ParallelFor(NumZones, [&](int32 ZoneId)
+    {
+        FZoneCA& Z = Zones[ZoneId];
+        if (Z.Box.IsEmpty()) return; // no cells
+        BuildZoneMasks(MapGrid, ZoneLabels, ZoneId, Settings, PassageCells, Z);
+        FRandomStream ZoneRNG = MapGenZones::MakeZoneStream(BaseSeed, ZoneId);
+        RunZone(Settings, ZoneRNG, Z);
+    });
 
-        // Apply back to map for mutable cells only
-        for (int32 y = 0; y < H; ++y)
-        for (int32 x = 0; x < W; ++x)
+    // Apply back to map for mutable cells only
+    for (int32 ZoneId = 0; ZoneId < NumZones; ++ZoneId)
+    {
+        const FZoneCA& Z = Zones[ZoneId];
+        if (Z.Box.IsEmpty()) continue;
+        for (int32 y = Z.Box.Min.Y; y < Z.Box.Max.Y; ++y)
+        for (int32 x = Z.Box.Min.X; x < Z.Box.Max.X; ++x)
         {
-            const int32 id = Idx(x, y, W);
-            if (ZoneLabels[id] != ZoneId) continue;
-            if (FixedState[id] != -1) continue; // leave immutable
+            const int32 id = Idx(x - Z.Box.Min.X + 1, y - Z.Box.Min.Y + 1, Z.PaddedW);
+            if (Z.Fixed[id] != -1) continue; // leave immutable and other zones
 
-            if (Cur[id] == 1)
+            if (Z.Cur[id] == 1)
             {
                 MapGrid->AddOrUpdateObjectAt(x, y, Settings->WallObjectTag, Settings->WallDurability);
             }
@@ -95,141 +128,223 @@ bool UCaveGenerator::Generate(UMapGrid2D* MapGrid,
     return true;
 }
 
-void UCaveGenerator::BuildZoneMasks(UMapGrid2D* Map,
+void UCaveGenerator::BuildZoneMasks(const UMapGrid2D* Map,
                                     const TArray<int32>& Labels,
                                     int32 ZoneId,
                                     const UCaveGenSettings* Settings,
-                                    TArray<int8>& FixedState,
-                                    TArray<uint8>& Cur)
+                                    const TBitArray<>& PassageCells,
+                                    FZoneCA& Z) const
 {
-    const FIntPoint Size = Map->GetSize();
-    const int32 W = Size.X, H = Size.Y;
-    const TArray<FRoomInfo>& Rooms = Map->GetRooms();
-    const TArray<FZonePassage>& Passages = Map->GetPassages();
+    const int32 W = Map->GetSize().X;
+    const FIntRect& Box = Z.Box;
+    Z.PaddedW = Box.Width() + 2;
+    Z.PaddedH = Box.Height() + 2;
+    auto Local = [&](int32 X, int32 Y) { return Idx(X - Box.Min.X + 1, Y - Box.Min.Y + 1, Z.PaddedW); };
+
+    // Padding and cells of other zones count as plain walls and never change
+    Z.Fixed.Init(1, Z.PaddedW * Z.PaddedH);
+    Z.Cur.Init(1, Z.PaddedW * Z.PaddedH);
+
+    Map->ForEachCellInRect<EMapCellField::Object>(Box, [&](const FMapCellView& V)
+    {
+        const int32 gid = Idx(V.X, V.Y, W);
+        if (Labels[gid] != ZoneId) return;
+        const int32 id = Local(V.X, V.Y);
 
-    // Precompute quick lookup for rooms and passages (immutable empty)
-    TSet<FIntPoint> ImmutableEmpty;
-    RoomWallCells.Reset();
-    for (const FRoomInfo& R : Rooms)
+        // Passage cells are immutable empty
+        if (PassageCells[gid])
+        {
+            Z.Fixed[id] = 0;
+            Z.Cur[id] = 0;
+            return;
+        }
+
+        // Check if there is an immutable wall object here (id 0 = no object is never in the mask)
+        if (ImmutableMask.Contains(V.ObjectId))
+        {
+            Z.Fixed[id] = 1; // immutable wall
+            Z.Cur[id] = 1;
+        }
+        else
+        {
+            Z.Fixed[id] = -1; // mutable cell
+            Z.Cur[id] = 0;
+        }
+    });
+
+    // Rooms of this zone are immutable empty; immutable walls around them weigh double (bias near room walls)
+    auto InZone = [&](int32 X, int32 Y) { return Box.Contains(FIntPoint(X, Y)) && Labels[Idx(X, Y, W)] == ZoneId; };
+    auto MarkRoomWall = [&](int32 X, int32 Y)
+    {
+        if (!InZone(X, Y)) return;
+        const int32 id = Local(X, Y);
+        if (Z.Fixed[id] == 1 && ImmutableMask.Contains(Map->GetObjectIdAt(X, Y))) Z.Cur[id] = 2;
+    };
+    for (const FRoomInfo& R : Map->GetRooms())
     {
         if (R.ZoneId != ZoneId) continue;
         for (int32 dy = 0; dy < R.Size.Y; ++dy)
         for (int32 dx = 0; dx < R.Size.X; ++dx)
         {
-            ImmutableEmpty.Add(FIntPoint(R.TopLeft.X + dx, R.TopLeft.Y + dy));
+            const int32 x = R.TopLeft.X + dx, y = R.TopLeft.Y + dy;
+            if (!InZone(x, y)) continue;
+            Z.Fixed[Local(x, y)] = 0;
+            Z.Cur[Local(x, y)] = 0;
         }
-
+    }
+    for (const FRoomInfo& R : Map->GetRooms())
+    {
+        if (R.ZoneId != ZoneId) continue;
         // Collect actual wall cells placed around the room (exclude entrance left open)
-        const int32 x0 = R.TopLeft.X;
-        const int32 y0 = R.TopLeft.Y;
-        const int32 w = R.Size.X;
-        const int32 h = R.Size.Y;
-        // Top and bottom edges
+        const int32 x0 = R.TopLeft.X, y0 = R.TopLeft.Y, w = R.Size.X, h = R.Size.Y;
         for (int32 dx = 0; dx < w; ++dx)
         {
-            const int32 xt = x0 + dx;
-            const int32 yt = y0;
-            const int32 xb = x0 + dx;
-            const int32 yb = y0 + h - 1;
-            FGameplayTag T; int32 D;
-            if (Map->GetObjectAt(xt, yt, T, D) && Settings->ImmutableObjectTags.Contains(T)) RoomWallCells.Add(FIntPoint(xt, yt));
-            if (Map->GetObjectAt(xb, yb, T, D) && Settings->ImmutableObjectTags.Contains(T)) RoomWallCells.Add(FIntPoint(xb, yb));
+            MarkRoomWall(x0 + dx, y0);
+            MarkRoomWall(x0 + dx, y0 + h - 1);
         }
-        // Left and right edges (skip corners)
-        for (int32 dy2 = 1; dy2 < h - 1; ++dy2)
+        for (int32 dy = 1; dy < h - 1; ++dy)
         {
-            const int32 xl = x0;
-            const int32 yl = y0 + dy2;
-            const int32 xr = x0 + w - 1;
-            const int32 yr = y0 + dy2;
-            FGameplayTag T; int32 D;
-            if (Map->GetObjectAt(xl, yl, T, D) && Settings->ImmutableObjectTags.Contains(T)) RoomWallCells.Add(FIntPoint(xl, yl));
-            if (Map->GetObjectAt(xr, yr, T, D) && Settings->ImmutableObjectTags.Contains(T)) RoomWallCells.Add(FIntPoint(xr, yr));
+            MarkRoomWall(x0, y0 + dy);
+            MarkRoomWall(x0 + w - 1, y0 + dy);
         }
     }
-    for (const FZonePassage& P : Passages)
+}
+
+void UCaveGenerator::RunZone(const UCaveGenSettings* Settings, FRandomStream& RNG, FZoneCA& Z) const
+{
+    const int32 PW = Z.PaddedW;
+    const int32 BW = Z.Box.Width(), BH = Z.Box.Height();
+
+    // Randomize mutable cells using FillChance (row-major over the zone)
+    for (int32 y = 1; y <= BH; ++y)
+    for (int32 x = 1; x <= BW; ++x)
     {
-        // Passages connect two zones; treat carved cells as immutable empty for CA
-        for (const FIntPoint& C : P.Cells)
+        const int32 id = Idx(x, y, PW);
+        if (Z.Fixed[id] == -1)
         {
-            ImmutableEmpty.Add(C);
+            Z.Cur[id] = (RNG.FRand() < Settings->FillChance) ? 1 : 0;
         }
     }
 
-    // Fill masks
-    for (int32 y = 0; y < H; ++y)
-    for (int32 x = 0; x < W; ++x)
+    if (Settings->Engine == ECaveCAEngine::BitParallel)
     {
-        const int32 id = Idx(x, y, W);
-        if (Labels[id] != ZoneId)
-        {
-            FixedState[id] = 1; // treat outside zone as wall for counting
-            Cur[id] = 1;
-            continue;
-        }
+        IterateBitParallel(Settings, Z);
+        return;
+    }
 
-        // Room interior or passage cells are immutable empty
-        if (ImmutableEmpty.Contains(FIntPoint(x, y)))
+    // Fixed cells hold the same weight in both buffers; only mutable cells are rewritten
+    TArray<uint8> Nxt = Z.Cur;
+    for (int iter = 0; iter < Settings->Iterations; ++iter)
+    {
+        const uint8* C = Z.Cur.GetData();
+        for (int32 y = 1; y <= BH; ++y)
         {
-            FixedState[id] = 0;
-            Cur[id] = 0;
-            continue;
-        }
+            const int32 Row = y * PW;
+            for (int32 x = 1; x <= BW; ++x)
+            {
+                const int32 id = Row + x;
+                if (Z.Fixed[id] != -1) continue;
 
-        // Check if there is a wall object here
-        FGameplayTag ObjTag; int32 Dur = 0;
-        const bool bHasObj = Map->GetObjectAt(x, y, ObjTag, Dur);
-        if (bHasObj && Settings->ImmutableObjectTags.Contains(ObjTag))
-        {
-            FixedState[id] = 1; // immutable wall
-            Cur[id] = 1;
-        }
-        else
-        {
-            FixedState[id] = -1; // mutable cell
-            Cur[id] = 0;
+                // Padding makes every neighbor in-bounds; out of map / other zones weigh 1
+                const int32 n = C[id - PW - 1] + C[id - PW] + C[id - PW + 1]
+                              + C[id - 1]                   + C[id + 1]
+                              + C[id + PW - 1] + C[id + PW] + C[id + PW + 1];
+                if (C[id] == 1)
+                {
+                    Nxt[id] = (n >= Settings->SurvivalLimit) ? 1 : 0;
+                }
+                else
+                {
+                    Nxt[id] = (n >= Settings->BirthLimit) ? 1 : 0;
+                }
+            }
         }
+        // swap buffers
+        Swap(Z.Cur, Nxt);
     }
 }
 
-int32 UCaveGenerator::CountNeighbors8(const TArray<int8>& Fixed,
-                                      const TArray<uint8>& Cur,
-                                      const TArray<int32>& Labels,
-                                      int32 ZoneId,
-                                      int32 X, int32 Y,
-                                      int32 W, int32 H) const
+void UCaveGenerator::IterateBitParallel(const UCaveGenSettings* Settings, FZoneCA& Z) const
 {
-    int32 Count = 0;
-    for (int dy = -1; dy <= 1; ++dy)
-    for (int dx = -1; dx <= 1; ++dx)
+    using namespace CaveBits;
+    const int32 PW = Z.PaddedW, PH = Z.PaddedH;
+    const int32 WPR = (PW + 63) >> 6;
+    const int32 NumWords = WPR * PH;
+
+    // Split the byte weights into bitplanes: Wall = weight >= 1, Bias = extra room-wall weight
+    TArray<uint64> Wall, Mutable, Bias;
+    Wall.SetNumZeroed(NumWords);
+    Mutable.SetNumZeroed(NumWords);
+    Bias.SetNumZeroed(NumWords);
+    bool bAnyBias = false;
+    for (int32 y = 0; y < PH; ++y)
+    for (int32 x = 0; x < PW; ++x)
     {
-        if (dx == 0 && dy == 0) continue;
-        const int nx = X + dx, ny = Y + dy;
-        if (nx < 0 || ny < 0 || nx >= W || ny >= H)
-        {
-            ++Count; // treat out of map as wall
-            continue;
-        }
-        const int id = Idx(nx, ny, W);
-        if (Labels[id] != ZoneId)
-        {
-            ++Count; // outside zone = wall
-            continue;
-        }
-        // Within zone: fixed overrides current
-        if (Fixed[id] == -1)
+        const int32 id = Idx(x, y, PW);
+        const int32 w = y * WPR + (x >> 6);
+        const uint64 Bit = uint64(1) << (x & 63);
+        if (Z.Cur[id] >= 1) Wall[w] |= Bit;
+        if (Z.Cur[id] == 2) { Bias[w] |= Bit; bAnyBias = true; }
+        if (Z.Fixed[id] == -1) Mutable[w] |= Bit;
+    }
+
+    // Bias cells never change, so their neighbor counts are computed once
+    TArray<uint64> BiasCount;
+    if (bAnyBias)
+    {
+        BiasCount.SetNumZeroed(NumWords * NumPlanes);
+        for (int32 y = 1; y < PH - 1; ++y)
+        for (int32 w = 0; w < WPR; ++w)
         {
-            if (Cur[id] == 1) ++Count;
+            uint64 Acc[NumPlanes] = {};
+            AddNeighbors(Acc, Bias.GetData(), WPR, y, w);
+            FMemory::Memcpy(&BiasCount[(y * WPR + w) * NumPlanes], Acc, sizeof(Acc));
         }
-        else
+    }
+
+    TArray<uint64> Next = Wall;
+    for (int iter = 0; iter < Settings->Iterations; ++iter)
+    {
+        for (int32 y = 1; y < PH - 1; ++y)
+        for (int32 w = 0; w < WPR; ++w)
         {
-            if (Fixed[id] == 1)
+            const int32 i = y * WPR + w;
+            const uint64 Mut = Mutable[i];
+            if (!Mut)
+            {
+                Next[i] = Wall[i];
+                continue;
+            }
+
+            uint64 Acc[NumPlanes] = {};
+            AddNeighbors(Acc, Wall.GetData(), WPR, y, w);
+            if (bAnyBias)
             {
-                // Immutable wall counts as a wall; if it's a room wall, add extra weight
-                ++Count;
-                if (RoomWallCells.Contains(FIntPoint(nx, ny))) ++Count; // bias near room walls
+                // Acc += BiasCount (bit-sliced ripple add)
+                const uint64* B = &BiasCount[i * NumPlanes];
+                uint64 Carry = 0;
+                for (int32 k = 0; k < NumPlanes; ++k)
+                {
+                    const uint64 A = Acc[k];
+                    Acc[k] = A ^ B[k] ^ Carry;
+                    Carry = (A & B[k]) | (Carry & (A ^ B[k]));
+                }
             }
+
+            const uint64 Cur = Wall[i];
+            const uint64 Alive = (Cur & GreaterEqual(Acc, Settings->SurvivalLimit))
+                               | (~Cur & GreaterEqual(Acc, Settings->BirthLimit));
+            Next[i] = (Cur & ~Mut) | (Alive & Mut);
         }
+        Swap(Wall, Next);
+    }
+
+    // Back to bytes for mutable cells
+    for (int32 y = 1; y < PH - 1; ++y)
+    for (int32 x = 1; x < PW - 1; ++x)
+    {
+        const int32 id = Idx(x, y, PW);
+        if (Z.Fixed[id] != -1) continue;
+        Z.Cur[id] = (Wall[y * WPR + (x >> 6)] >> (x & 63)) & 1;
     }
-    return Count;
 }
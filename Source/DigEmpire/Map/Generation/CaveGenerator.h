@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "CaveGenSettings.h"
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "CaveGenerator.generated.h"
 
 class UMapGrid2D;
@@ -19,23 +21,37 @@ public:
                   const TArray<int32>& ZoneLabels,
                   const UCaveGenSettings* Settings);
 
+    /** Same against a step context, whose zone bounds are shared with the other steps. */
+    bool Generate(FMapGenerationContext& Context, const UCaveGenSettings* Settings);
+
 private:
+    /**
+     * CA state of one zone over its bounding box, padded by one cell on every side.
+     * Index = (X - Box.Min.X + 1) + (Y - Box.Min.Y + 1) * PaddedW.
+     */
+    struct FZoneCA
+    {
+        FIntRect Box;          // zone bounds in map cells (Max exclusive)
+        int32 PaddedW = 0;
+        int32 PaddedH = 0;
+        TArray<int8> Fixed;    // -1 mutable, 0 immutable empty, 1 immutable wall (padding / other zones included)
+        TArray<uint8> Cur;     // mutable: 0/1; fixed: neighbor weight (0 empty, 1 wall, 2 room wall)
+    };
+
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
 
-    void BuildZoneMasks(UMapGrid2D* Map,
+    void BuildZoneMasks(const UMapGrid2D* Map,
                         const TArray<int32>& Labels,
                         int32 ZoneId,
                         const UCaveGenSettings* Settings,
-                        /*out*/ TArray<int8>& FixedState, // -1 mutable, 0 immutable empty, 1 immutable wall
-                        /*out*/ TArray<uint8>& Cur);
-
-    int32 CountNeighbors8(const TArray<int8>& Fixed,
-                          const TArray<uint8>& Cur,
-                          const TArray<int32>& Labels,
-                          int32 ZoneId,
-                          int32 X, int32 Y,
-                          int32 W, int32 H) const;
-
-    // Cached for current zone to bias walls near room walls
-    TSet<FIntPoint> RoomWallCells;
+                        const TBitArray<>& PassageCells,
+                        /*in/out*/ FZoneCA& Zone) const;
+
+    void RunZone(const UCaveGenSettings* Settings, FRandomStream& RNG, FZoneCA& Zone) const;
+
+    /** Smoothing iterations on 64-cell words; same results as the scalar loop in RunZone. */
+    void IterateBitParallel(const UCaveGenSettings* Settings, FZoneCA& Zone) const;
+
+    // ImmutableObjectTags resolved to map palette ids
+    FMapTagMask ImmutableMask;
 };
@@ -1,10 +1,13 @@
 #include "CellActorPlacementSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "CellActorPlacer.h"
 
-void UCellActorPlacementSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& /*InOutZoneLabels*/) const
+void UCellActorPlacementSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
+    UWorld* World = Context.GetWorld();
     if (!Map || !World) return;
     if (Placements.Num() == 0) return;
     UCellActorPlacer* Placer = NewObject<UCellActorPlacer>();
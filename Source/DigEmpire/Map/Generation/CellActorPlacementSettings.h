@@ -56,6 +56,9 @@ public:
     int32 RandomSeed = -1;
 
     // Execute step: place actors in specified zones into empty cells
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    // Spawns actors
+    virtual bool RequiresGameThread() const override { return true; }
 };
 
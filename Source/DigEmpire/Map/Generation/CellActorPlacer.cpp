@@ -92,8 +92,7 @@ void UCellActorPlacer::CollectCandidatesForZone(UMapGrid2D* Map,
                     if (!Map->IsInBounds(x, y)) continue;
                     if (Map->GetZoneAt(x, y) != ZoneId) continue;
                     if (Map->GetActorAt(x, y)) continue;
-                    FGameplayTag Obj; int32 Dur;
-                    if (Map->GetObjectAt(x, y, Obj, Dur)) continue; // must be empty
+                    if (Map->HasObjectAt(x, y)) continue; // must be empty
                     OutCandidates.Add(FIntPoint(x, y));
                 }
             }
@@ -124,17 +123,13 @@ void UCellActorPlacer::CollectCandidatesForZone(UMapGrid2D* Map,
             }
         }
 
-        for (int32 y = 0; y < Size.Y; ++y)
+        // Walk only this zone's cells (falls back to a plane scan if the zone index is stale)
+        for (const FIntPoint& C : Map->GetCellsForZone(ZoneId))
         {
-            for (int32 x = 0; x < Size.X; ++x)
-            {
-                if (Map->GetZoneAt(x, y) != ZoneId) continue;
-                if (RoomCells.Contains(ToIndex(x, y))) continue;
-                if (Map->GetActorAt(x, y)) continue;
-                FGameplayTag Obj; int32 Dur;
-                if (Map->GetObjectAt(x, y, Obj, Dur)) continue; // must be empty
-                OutCandidates.Add(FIntPoint(x, y));
-            }
+            if (RoomCells.Contains(ToIndex(C.X, C.Y))) continue;
+            if (Map->GetActorAt(C.X, C.Y)) continue;
+            if (Map->HasObjectAt(C.X, C.Y)) continue; // must be empty
+            OutCandidates.Add(C);
         }
     }
 }
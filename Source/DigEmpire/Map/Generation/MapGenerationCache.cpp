@@ -0,0 +1,162 @@
+#include "MapGenerationCache.h"
+
+#include "MapGenerationReport.h"
+#include "MapGenerationStepDataBase.h"
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "GameplayTagContainer.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/SecureHash.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** Bump when the entry format changes; generator code changes are covered by GetCodeVersion */
+    constexpr int32 CacheVersion = 2;
+
+    /** Timestamp of the game module binary (the executable in monolithic builds); changes with every rebuild. */
+    FDateTime GetBinaryTimeStamp()
+    {
+        static const FDateTime Stamp = []()
+        {
+            FString Binary = FModuleManager::Get().GetModuleFilename(TEXT("DigEmpire"));
+            if (Binary.IsEmpty())
+            {
+                Binary = FPlatformProcess::ExecutablePath();
+            }
+            return IFileManager::Get().GetTimeStamp(*Binary);
+        }();
+        return Stamp;
+    }
+
+    FString GetCodeVersion()
+    {
+        return FString::Printf(TEXT("%s %lld"), FApp::GetBuildVersion(), GetBinaryTimeStamp().GetTicks());
+    }
+
+    void HashString(FSHA1& Sha, const FString& S)
+    {
+        Sha.UpdateWithString(*S, S.Len());
+        const TCHAR Sep = TEXT('\n');
+        Sha.Update(reinterpret_cast<const uint8*>(&Sep), sizeof(Sep));
+    }
+
+    /** Class path plus every non-transient property in declaration order. False if the seed is not fixed. */
+    bool HashStep(FSHA1& Sha, const UMapGenerationStepDataBase* Step)
+    {
+        const UClass* Class = Step->GetClass();
+        HashString(Sha, Class->GetPathName());
+
+        if (const FIntProperty* SeedProp = FindFProperty<FIntProperty>(Class, TEXT("RandomSeed")))
+        {
+            if (SeedProp->GetPropertyValue_InContainer(Step) < 0)
+            {
+                return false;
+            }
+        }
+
+        for (TFieldIterator<FProperty> It(Class); It; ++It)
+        {
+            const FProperty* Prop = *It;
+            if (Prop->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient)) continue;
+
+            FString Value;
+            Prop->ExportText_InContainer(0, Value, Step, nullptr, nullptr, PPF_None);
+            HashString(Sha, Prop->GetName());
+            HashString(Sha, Value);
+        }
+        return true;
+    }
+
+    FString GetCacheDir()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MapCache"));
+    }
+
+    /** Entries written before the current binary was built can no longer be hit; drop them once per run. */
+    void PruneStaleEntries()
+    {
+        static bool bPruned = false;
+        if (bPruned) return;
+        bPruned = true;
+
+        const FDateTime BinaryStamp = GetBinaryTimeStamp();
+        if (BinaryStamp == FDateTime::MinValue()) return;
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *FPaths::Combine(GetCacheDir(), TEXT("*.demap")), /*Files*/ true, /*Directories*/ false);
+        for (const FString& File : Files)
+        {
+            const FString Path = FPaths::Combine(GetCacheDir(), File);
+            if (IFileManager::Get().GetTimeStamp(*Path) < BinaryStamp)
+            {
+                IFileManager::Get().Delete(*Path);
+            }
+        }
+    }
+}
+
+bool MapGenCache::ComputeKey(FIntPoint MapSize,
+                             bool bChunkedStorage,
+                             const FGameplayTag& BackgroundTag,
+                             const TArray<const UMapGenerationStepDataBase*>& Steps,
+                             FString& OutKey)
+{
+    OutKey.Reset();
+    if (Steps.Num() == 0) return false;
+
+    FSHA1 Sha;
+    HashString(Sha, FString::Printf(TEXT("v%d %dx%d %d"), CacheVersion, MapSize.X, MapSize.Y, bChunkedStorage ? 1 : 0));
+    HashString(Sha, GetCodeVersion());
+    HashString(Sha, BackgroundTag.ToString());
+    for (const UMapGenerationStepDataBase* Step : Steps)
+    {
+        if (!HashStep(Sha, Step)) return false;
+    }
+    Sha.Final();
+
+    FSHAHash Hash;
+    Sha.GetHash(Hash.Hash);
+    OutKey = Hash.ToString();
+    return true;
+}
+
+FString MapGenCache::GetEntryPath(const FString& Key)
+{
+    return FPaths::Combine(GetCacheDir(), Key + TEXT(".demap"));
+}
+
+bool MapGenCache::Load(const FString& Key, TArray<uint8>& OutBytes)
+{
+    const FString Path = GetEntryPath(Key);
+    return IFileManager::Get().FileExists(*Path) && FFileHelper::LoadFileToArray(OutBytes, *Path);
+}
+
+bool MapGenCache::Store(const FString& Key, const UMapGrid2D* Map)
+{
+    if (!Map) return false;
+
+    TArray<uint8> Bytes;
+    Map->SaveToBytes(Bytes);
+    if (Bytes.Num() == 0) return false;
+
+    // Write next to the entry and move into place so a crash never leaves a truncated entry
+    const FString Path = GetEntryPath(Key);
+    const FString TempPath = Path + TEXT(".tmp");
+    PruneStaleEntries();
+    IFileManager::Get().MakeDirectory(*GetCacheDir(), /*Tree*/ true);
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, /*Replace*/ true))
+    {
+        IFileManager::Get().Delete(*TempPath);
+        UE_LOG(LogDigEmpireMapGen, Warning, TEXT("Could not write map cache entry %s"), *Path);
+        return false;
+    }
+    return true;
+}
+
+void MapGenCache::Remove(const FString& Key)
+{
+    IFileManager::Get().Delete(*GetEntryPath(Key));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMapGrid2D;
+class UMapGenerationStepDataBase;
+struct FGameplayTag;
+
+/**
+ * Local cache of fully built maps (Saved/MapCache), keyed by a hash of everything that feeds generation.
+ *
+ * Only deterministic setups are cached: every step must have RandomSeed >= 0. The key covers the
+ * map size, storage mode, background tag and, in list order, each step's class and exported
+ * property values, so editing any setting (or a seed) misses the cache and regenerates. It also
+ * covers the build version and the timestamp of the binary holding the generators, so every
+ * rebuild of the game code starts from an empty cache instead of serving maps of older code.
+ * Entries are UMapGrid2D::SaveToBytes blobs; cell actors placed by the steps come back as records.
+ */
+namespace MapGenCache
+{
+    /**
+     * Cache key of a build, or false if the setup is not deterministic (some step without a fixed seed).
+     * Assets referenced by the steps are hashed by path only.
+     */
+    bool ComputeKey(FIntPoint MapSize,
+                    bool bChunkedStorage,
+                    const FGameplayTag& BackgroundTag,
+                    const TArray<const UMapGenerationStepDataBase*>& Steps,
+                    FString& OutKey);
+
+    /** File of a cache entry. */
+    FString GetEntryPath(const FString& Key);
+
+    /** Read an entry; false on a miss. */
+    bool Load(const FString& Key, TArray<uint8>& OutBytes);
+
+    /** Write a finished map under Key (replaces an existing entry). */
+    bool Store(const FString& Key, const UMapGrid2D* Map);
+
+    /** Drop an entry that failed to load. */
+    void Remove(const FString& Key);
+}
@@ -0,0 +1,167 @@
+#include "MapGenerationContext.h"
+
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "Misc/ScopeLock.h"
+
+uint32 MapGenZones::MakeBaseSeed(int32 Seed)
+{
+    FRandomStream RNG(Seed);
+    if (Seed < 0) RNG.GenerateNewSeed();
+    return static_cast<uint32>(RNG.GetCurrentSeed());
+}
+
+void MapGenZones::ComputeZoneBounds(const TArray<int32>& Labels, int32 Width, TArray<FIntRect>& OutBounds)
+{
+    OutBounds.Reset();
+    if (Width <= 0) return;
+    for (int32 id = 0; id < Labels.Num(); ++id)
+    {
+        const int32 z = Labels[id];
+        if (z < 0) continue;
+        const FIntPoint P(id % Width, id / Width);
+        if (z >= OutBounds.Num())
+        {
+            OutBounds.SetNum(z + 1); // new zones start empty
+        }
+        FIntRect& B = OutBounds[z];
+        if (B.IsEmpty())
+        {
+            B = FIntRect(P, P + FIntPoint(1, 1));
+        }
+        else
+        {
+            B.Min = B.Min.ComponentMin(P);
+            B.Max = B.Max.ComponentMax(P + FIntPoint(1, 1));
+        }
+    }
+}
+
+void FMapGenerationContext::SetZoneLabels(TArray<int32>&& InLabels)
+{
+    SetZoneLabels(MakeShared<TArray<int32>, ESPMode::ThreadSafe>(MoveTemp(InLabels)));
+}
+
+void FMapGenerationContext::SetZoneLabels(const FMapZoneLabelsRef& InLabels)
+{
+    FScopeLock ScopeLock(&ZoneBoundsLock);
+    ZoneLabels = InLabels;
+    ZoneBounds.Reset();
+    bZoneBoundsValid = false;
+}
+
+void FMapGenerationContext::ResetZoneLabels()
+{
+    SetZoneLabels(MakeShared<TArray<int32>, ESPMode::ThreadSafe>());
+}
+
+TConstArrayView<FIntRect> FMapGenerationContext::GetZoneBounds()
+{
+    FScopeLock ScopeLock(&ZoneBoundsLock);
+    if (!bZoneBoundsValid)
+    {
+        MapGenZones::ComputeZoneBounds(*ZoneLabels, Map ? Map->GetSize().X : 0, ZoneBounds);
+        bZoneBoundsValid = true;
+    }
+    return ZoneBounds;
+}
+
+void* FMapGenScratchArena::AllocBytes(SIZE_T Size, SIZE_T Alignment)
+{
+    if (Size == 0) return nullptr;
+
+    FScopeLock ScopeLock(&Lock);
+    for (; CurrentBlock < Blocks.Num(); ++CurrentBlock)
+    {
+        FBlock& B = Blocks[CurrentBlock];
+        const SIZE_T Offset = Align(B.Used, Alignment);
+        if (Offset + Size <= B.Size)
+        {
+            B.Used = Offset + Size;
+            return B.Data + Offset;
+        }
+    }
+
+    // Grow geometrically so a build settles on a few blocks, which Reset then merges
+    const SIZE_T Last = Blocks.Num() > 0 ? Blocks.Last().Size : 0;
+    FBlock& B = Blocks.AddDefaulted_GetRef();
+    B.Size = FMath::Max3(MinBlockSize, Size + Alignment, Last * 2);
+    B.Data = static_cast<uint8*>(FMemory::Malloc(B.Size, 64));
+    CurrentBlock = Blocks.Num() - 1;
+
+    const SIZE_T Offset = Align(B.Used, Alignment);
+    B.Used = Offset + Size;
+    return B.Data + Offset;
+}
+
+void FMapGenScratchArena::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    ResetLocked();
+}
+
+void FMapGenScratchArena::ResetLocked()
+{
+    if (Blocks.Num() > 1)
+    {
+        SIZE_T Total = 0;
+        for (const FBlock& B : Blocks)
+        {
+            Total += B.Size;
+            FMemory::Free(B.Data);
+        }
+        Blocks.Reset();
+        FBlock& Merged = Blocks.AddDefaulted_GetRef();
+        Merged.Size = Total;
+        Merged.Data = static_cast<uint8*>(FMemory::Malloc(Total, 64));
+    }
+    for (FBlock& B : Blocks)
+    {
+        B.Used = 0;
+    }
+    CurrentBlock = 0;
+}
+
+void FMapGenScratchArena::Trim()
+{
+    FScopeLock ScopeLock(&Lock);
+    check(NumUsers == 0);
+    for (const FBlock& B : Blocks)
+    {
+        FMemory::Free(B.Data);
+    }
+    Blocks.Empty();
+    CurrentBlock = 0;
+}
+
+int64 FMapGenScratchArena::GetUsedBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    int64 Used = 0;
+    for (const FBlock& B : Blocks) Used += B.Used;
+    return Used;
+}
+
+int64 FMapGenScratchArena::GetReservedBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    int64 Reserved = 0;
+    for (const FBlock& B : Blocks) Reserved += B.Size;
+    return Reserved;
+}
+
+void FMapGenScratchArena::BeginUse()
+{
+    FScopeLock ScopeLock(&Lock);
+    ++NumUsers;
+}
+
+void FMapGenScratchArena::EndUse()
+{
+    // Concurrent steps share the arena, so it is only rewound once all of them are done
+    FScopeLock ScopeLock(&Lock);
+    check(NumUsers > 0);
+    if (--NumUsers == 0)
+    {
+        ResetLocked();
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+class UMapGrid2D;
+class UWorld;
+
+/** Read-only zone labels (index = X + Y*SizeX, -1 = unlabeled) shared between steps, generators and checkpoints. */
+using FMapZoneLabelsRef = TSharedRef<const TArray<int32>, ESPMode::ThreadSafe>;
+
+/**
+ * Bump allocator for per-step scratch buffers (distance fields, BFS queues, ...).
+ *
+ * Allocation is thread-safe and O(1); nothing is freed individually. The owning context rewinds
+ * the arena once no step is running, keeping its memory, so the same blocks serve every later
+ * step; owners Trim it when the build is done unless they expect reruns. Only trivially
+ * destructible types.
+ */
+class FMapGenScratchArena
+{
+public:
+    FMapGenScratchArena() = default;
+    ~FMapGenScratchArena() { Trim(); }
+    FMapGenScratchArena(const FMapGenScratchArena&) = delete;
+    FMapGenScratchArena& operator=(const FMapGenScratchArena&) = delete;
+
+    /** Num uninitialized elements, valid until the arena is rewound (end of the step). */
+    template<typename T>
+    TArrayView<T> Alloc(int32 Num)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Scratch memory is released without running destructors");
+        return TArrayView<T>(static_cast<T*>(AllocBytes(sizeof(T) * SIZE_T(FMath::Max(0, Num)), alignof(T))), FMath::Max(0, Num));
+    }
+
+    /** Num elements set to Value. */
+    template<typename T>
+    TArrayView<T> Alloc(int32 Num, const T& Value)
+    {
+        TArrayView<T> Out = Alloc<T>(Num);
+        for (T& E : Out) E = Value;
+        return Out;
+    }
+
+    /** Rewind; memory is kept (several blocks are merged into one for the next round). */
+    void Reset();
+
+    /** Release all memory. */
+    void Trim();
+
+    /** Bytes handed out since the last rewind / bytes held. */
+    int64 GetUsedBytes() const;
+    int64 GetReservedBytes() const;
+
+    /** Rewound when the last user ends (see FMapGenerationContext::BeginStep). */
+    void BeginUse();
+    void EndUse();
+
+private:
+    struct FBlock
+    {
+        uint8* Data = nullptr;
+        SIZE_T Size = 0;
+        SIZE_T Used = 0;
+    };
+
+    static constexpr SIZE_T MinBlockSize = 1 << 20;
+
+    void* AllocBytes(SIZE_T Size, SIZE_T Alignment);
+    void ResetLocked();
+
+    mutable FCriticalSection Lock;
+    TArray<FBlock> Blocks;
+    int32 CurrentBlock = 0;
+    int32 NumUsers = 0;
+};
+
+/**
+ * Helpers for generators that work zone by zone.
+ *
+ * Zones run in a ParallelFor: a zone only reads the map and its own buffers, and the results are
+ * written back afterwards on the calling thread because map writes are not thread-safe. Every zone
+ * draws from its own stream derived from one base seed, so the output does not depend on the
+ * order the zones run in.
+ */
+namespace MapGenZones
+{
+    /** Seed if >= 0, otherwise a fresh random seed. */
+    uint32 MakeBaseSeed(int32 Seed);
+
+    /** Random stream of one zone. */
+    inline FRandomStream MakeZoneStream(uint32 BaseSeed, int32 ZoneId)
+    {
+        return FRandomStream(static_cast<int32>(HashCombine(BaseSeed, GetTypeHash(ZoneId))));
+    }
+
+    /** Bounding rect per zone id (Max exclusive, empty if the zone has no cells) in one pass over Labels. */
+    void ComputeZoneBounds(const TArray<int32>& Labels, int32 Width, TArray<FIntRect>& OutBounds);
+}
+
+/**
+ * State a generation build hands to its steps (see UMapGenerationStepDataBase::ExecuteGenerationStep).
+ *
+ * Holds the target map and world (null on worker threads), the zone labels of the build as one
+ * shared immutable array (steps and generators keep references instead of copies; a step that
+ * produces labels replaces the array) and the scratch arena for step-local buffers.
+ * One context lives for the whole build; owners may keep it across builds (see FMapGenScratchArena::Trim).
+ */
+class FMapGenerationContext
+{
+public:
+    FMapGenerationContext() = default;
+    FMapGenerationContext(UMapGrid2D* InMap, UWorld* InWorld) : Map(InMap), World(InWorld) {}
+    FMapGenerationContext(const FMapGenerationContext&) = delete;
+    FMapGenerationContext& operator=(const FMapGenerationContext&) = delete;
+
+    /** Retarget to another map/world (labels are kept; call ResetZoneLabels for a fresh build). */
+    void Bind(UMapGrid2D* InMap, UWorld* InWorld) { Map = InMap; World = InWorld; bZoneBoundsValid = false; }
+
+    UMapGrid2D* GetMap() const { return Map; }
+    UWorld* GetWorld() const { return World; }
+
+    // Zone labels
+    bool HasZoneLabels() const { return ZoneLabels->Num() > 0; }
+    const TArray<int32>& GetZoneLabels() const { return *ZoneLabels; }
+    FMapZoneLabelsRef ShareZoneLabels() const { return ZoneLabels; }
+    void SetZoneLabels(TArray<int32>&& InLabels);
+    void SetZoneLabels(const FMapZoneLabelsRef& InLabels);
+    void ResetZoneLabels();
+
+    /**
+     * Bounding rect per zone id of the current labels (see MapGenZones::ComputeZoneBounds).
+     * Computed once per label set on first use, so the zone steps of a build share one pass.
+     */
+    TConstArrayView<FIntRect> GetZoneBounds();
+
+    /** Scratch for the running step; rewound between steps. */
+    FMapGenScratchArena& GetScratch() { return Scratch; }
+
+    /** Called by the step runner around ExecuteGenerationStep. */
+    void BeginStep() { Scratch.BeginUse(); }
+    void EndStep() { Scratch.EndUse(); }
+
+private:
+    UMapGrid2D* Map = nullptr;
+    UWorld* World = nullptr;
+    FMapZoneLabelsRef ZoneLabels = MakeShared<TArray<int32>, ESPMode::ThreadSafe>();
+    TArray<FIntRect> ZoneBounds;
+    bool bZoneBoundsValid = false;
+    FCriticalSection ZoneBoundsLock; // steps without a dependency between them may ask concurrently
+    FMapGenScratchArena Scratch;
+};
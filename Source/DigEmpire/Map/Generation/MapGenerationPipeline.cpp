@@ -0,0 +1,101 @@
+#include "MapGenerationPipeline.h"
+
+#include "MapGenerationStepDataBase.h"
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "UObject/GarbageCollection.h"
+
+namespace
+{
+    // Shared state implied by the public access bits (see ExpandAccess)
+    constexpr uint32 AccessPalette   = 1u << 30;
+    constexpr uint32 AccessFreeCells = 1u << 31;
+
+    /** Add the grid-internal state that plane accesses touch implicitly. */
+    void ExpandAccess(uint32& Read, uint32& Write)
+    {
+        // Tag planes go through the shared palette: writes may intern, reads look ids up
+        constexpr uint32 Tagged = EMapGenAccess::Background | EMapGenAccess::Objects | EMapGenAccess::Ore;
+        if (Write & Tagged) Write |= AccessPalette;
+        if (Read & Tagged) Read |= AccessPalette;
+
+        // Object/actor writes and zone writes both maintain the per-zone free-cell lists
+        if (Write & (EMapGenAccess::Objects | EMapGenAccess::Actors))
+        {
+            Write |= AccessFreeCells;
+            Read |= EMapGenAccess::Zones;
+        }
+        if (Write & EMapGenAccess::Zones) Write |= AccessFreeCells;
+        if (Read & EMapGenAccess::Zones) Read |= AccessFreeCells;
+    }
+}
+
+FMapGenerationPipeline::FMapGenerationPipeline(UMapGrid2D* InMap, const TArray<const UMapGenerationStepDataBase*>& InSteps)
+    : Context(InMap, /*World*/ nullptr)
+    , Steps(InSteps)
+{
+    while (NumWorkerSteps < Steps.Num() && !Steps[NumWorkerSteps]->RequiresGameThread())
+    {
+        ++NumWorkerSteps;
+    }
+}
+
+FMapGenerationPipeline::~FMapGenerationPipeline()
+{
+    Cancel();
+    UE::Tasks::Wait(StepTasks);
+}
+
+bool FMapGenerationPipeline::StepsConflict(const UMapGenerationStepDataBase* Earlier, const UMapGenerationStepDataBase* Later)
+{
+    uint32 ReadA = Earlier->GetReadAccess(), WriteA = Earlier->GetWriteAccess();
+    uint32 ReadB = Later->GetReadAccess(), WriteB = Later->GetWriteAccess();
+    ExpandAccess(ReadA, WriteA);
+    ExpandAccess(ReadB, WriteB);
+    return (WriteA & (ReadB | WriteB)) != 0 || (ReadA & WriteB) != 0;
+}
+
+void FMapGenerationPipeline::Launch()
+{
+    check(StepTasks.Num() == 0);
+    StepTasks.Reserve(NumWorkerSteps);
+    StepReports.SetNum(NumWorkerSteps);
+    LaunchSeconds = FPlatformTime::Seconds();
+    if (NumWorkerSteps == 0) FinishSeconds = LaunchSeconds;
+    for (int32 i = 0; i < NumWorkerSteps; ++i)
+    {
+        TArray<UE::Tasks::FTask> Prereqs;
+        for (int32 j = 0; j < i; ++j)
+        {
+            if (StepsConflict(Steps[j], Steps[i]))
+            {
+                Prereqs.Add(StepTasks[j]);
+            }
+        }
+        StepTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, i]() { RunStep(i); }, Prereqs));
+    }
+}
+
+bool FMapGenerationPipeline::IsWorkerPhaseDone() const
+{
+    for (const UE::Tasks::FTask& Task : StepTasks)
+    {
+        if (!Task.IsCompleted()) return false;
+    }
+    return true;
+}
+
+void FMapGenerationPipeline::RunStep(int32 StepIndex)
+{
+    if (bCancelled) return;
+    {
+        // Steps create transient generator objects; keep GC from collecting them mid-step
+        FGCScopeGuard GCGuard;
+        MapGenReport::ExecuteStep(Steps[StepIndex], Context, StepReports[StepIndex]);
+    }
+    LastFinishedStep.store(StepIndex, std::memory_order_release);
+    const double End = FPlatformTime::Seconds();
+    if (StepsDone.fetch_add(1, std::memory_order_acq_rel) + 1 == NumWorkerSteps)
+    {
+        FinishSeconds = End; // read by the owner only after the tasks completed
+    }
+}
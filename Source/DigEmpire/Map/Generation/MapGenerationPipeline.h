@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "MapGenerationReport.h"
+#include "MapGenerationContext.h"
+#include <atomic>
+
+class UMapGrid2D;
+class UMapGenerationStepDataBase;
+
+/**
+ * Runs generation steps off the game thread as a task graph against a private grid.
+ *
+ * The graph covers the steps before the first one that RequiresGameThread(); that step and
+ * everything after it are left to the owner, which runs them on the game thread once
+ * IsWorkerPhaseDone(). Each step waits for every earlier step whose declared access
+ * (GetReadAccess/GetWriteAccess) conflicts with its own, so independent steps overlap while
+ * the result matches running the list in order.
+ *
+ * The owner keeps the grid and the step assets alive and polls from the game thread.
+ * Destroying the pipeline cancels the remaining steps and waits for the running one.
+ */
+class FMapGenerationPipeline
+{
+public:
+    FMapGenerationPipeline(UMapGrid2D* InMap, const TArray<const UMapGenerationStepDataBase*>& InSteps);
+    ~FMapGenerationPipeline();
+
+    /** Start the worker graph (call once). */
+    void Launch();
+
+    /** Skip steps that have not started yet. */
+    void Cancel() { bCancelled = true; }
+
+    /** True once every worker step has finished (or been skipped). */
+    bool IsWorkerPhaseDone() const;
+
+    /** Block until the worker phase is done (headless callers; the game thread should poll instead). */
+    void Wait() { UE::Tasks::Wait(StepTasks); }
+
+    int32 GetNumSteps() const { return Steps.Num(); }
+    int32 GetNumWorkerSteps() const { return NumWorkerSteps; }
+    const UMapGenerationStepDataBase* GetStep(int32 StepIndex) const { return Steps[StepIndex]; }
+
+    /** Worker steps finished so far (safe to read from any thread). */
+    int32 GetStepsDone() const { return StepsDone.load(std::memory_order_acquire); }
+
+    /** Index of the most recently finished worker step, or INDEX_NONE. */
+    int32 GetLastFinishedStep() const { return LastFinishedStep.load(std::memory_order_acquire); }
+
+    /** True if Later must wait for Earlier (some plane written by one is read or written by the other). */
+    static bool StepsConflict(const UMapGenerationStepDataBase* Earlier, const UMapGenerationStepDataBase* Later);
+
+    /** Wall time from Launch to the end of the last worker step (overlapping steps counted once); only read once IsWorkerPhaseDone(). */
+    double GetWorkerSeconds() const { return FinishSeconds > 0.0 ? FinishSeconds - LaunchSeconds : 0.0; }
+
+    /** Measurements of the worker steps (StepName empty = skipped); only read once IsWorkerPhaseDone(). */
+    const TArray<FMapGenStepReport>& GetStepReports() const { return StepReports; }
+
+    /** Context the worker steps ran against (zone labels, scratch); only touch once IsWorkerPhaseDone(). */
+    FMapGenerationContext& GetContext() { return Context; }
+
+private:
+    void RunStep(int32 StepIndex);
+
+    FMapGenerationContext Context; // private map, no world
+    TArray<const UMapGenerationStepDataBase*> Steps;
+    int32 NumWorkerSteps = 0;
+    TArray<FMapGenStepReport> StepReports; // one slot per worker step, written only by its task
+
+    std::atomic<int32> StepsDone{0};
+    std::atomic<int32> LastFinishedStep{INDEX_NONE};
+    std::atomic<bool> bCancelled{false};
+    TArray<UE::Tasks::FTask> StepTasks;
+    double LaunchSeconds = 0.0;
+    double FinishSeconds = 0.0; // set by the step that completes the worker phase
+};
@@ -0,0 +1,76 @@
+#include "MapGenerationReport.h"
+
+#include "MapGenerationStepDataBase.h"
+#include "MapGenerationContext.h"
+#include "DigEmpire/Map/MapGrid2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DEFINE_LOG_CATEGORY(LogDigEmpireMapGen);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cells mutated"), STAT_MapGenCellsMutated, STATGROUP_DigEmpireMapGen);
+
+void MapGenReport::ExecuteStep(const UMapGenerationStepDataBase* Step,
+                               FMapGenerationContext& Context,
+                               FMapGenStepReport& Out)
+{
+    const UMapGrid2D* Map = Context.GetMap();
+    Out.StepName = Step->GetName();
+    Out.StepClass = Step->GetClass()->GetName();
+    Out.bGameThread = IsInGameThread();
+
+    const uint64 ChangesBefore = Map ? Map->GetCellChangeCount() : 0;
+    const double Start = FPlatformTime::Seconds();
+    Context.BeginStep();
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Out.StepName);
+#if STATS
+        // One cycle stat per step class, so steps running side by side do not fold into one counter
+        FScopeCycleCounter StepCycles(FDynamicStats::CreateStatId<FStatGroup_STATGROUP_DigEmpireMapGen>(Out.StepClass));
+#endif
+        LLM_SCOPE_BYNAME(TEXT("DigEmpire/MapGen"));
+        Step->ExecuteGenerationStep(Context);
+        // Sampled before EndStep, which may rewind the arena
+        Out.ScratchArenaBytes = Context.GetScratch().GetUsedBytes();
+    }
+    Context.EndStep();
+    Out.WallSeconds = FPlatformTime::Seconds() - Start;
+
+    Out.CellsMutated = Map ? Map->GetCellChangeCount() - ChangesBefore : 0;
+    INC_DWORD_STAT_BY(STAT_MapGenCellsMutated, (uint32)FMath::Min<uint64>(Out.CellsMutated, MAX_uint32));
+}
+
+void FMapGenReport::Log() const
+{
+    UE_LOG(LogDigEmpireMapGen, Log, TEXT("Map %dx%d built in %.2f ms (%d steps)"),
+        MapSize.X, MapSize.Y, TotalSeconds * 1000.0, Steps.Num());
+    for (const FMapGenStepReport& S : Steps)
+    {
+        UE_LOG(LogDigEmpireMapGen, Log, TEXT("  %-32s %-28s %s %9.2f ms %10lld KB %10llu cells"),
+            *S.StepName, *S.StepClass, S.bGameThread ? TEXT("GT") : TEXT("WT"),
+            S.WallSeconds * 1000.0, S.ScratchArenaBytes / 1024, S.CellsMutated);
+    }
+}
+
+bool FMapGenReport::AppendToCsv(const FString& FilePath) const
+{
+    FString Out;
+    if (!IFileManager::Get().FileExists(*FilePath))
+    {
+        Out += TEXT("Timestamp,MapSizeX,MapSizeY,Step,Class,GameThread,WallMs,ScratchArenaKB,CellsMutated\n");
+    }
+
+    const FString Stamp = FDateTime::Now().ToIso8601();
+    for (const FMapGenStepReport& S : Steps)
+    {
+        Out += FString::Printf(TEXT("%s,%d,%d,%s,%s,%d,%.3f,%lld,%llu\n"),
+            *Stamp, MapSize.X, MapSize.Y, *S.StepName, *S.StepClass, S.bGameThread ? 1 : 0,
+            S.WallSeconds * 1000.0, S.ScratchArenaBytes / 1024, S.CellsMutated);
+    }
+    Out += FString::Printf(TEXT("%s,%d,%d,Total,,,%.3f,,\n"), *Stamp, MapSize.X, MapSize.Y, TotalSeconds * 1000.0);
+
+    return FFileHelper::SaveStringToFile(Out, *FilePath, FFileHelper::EEncodingOptions::AutoDetect,
+        &IFileManager::Get(), FILEWRITE_Append);
+}
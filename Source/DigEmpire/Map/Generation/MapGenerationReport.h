@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+class UMapGenerationStepDataBase;
+class FMapGenerationContext;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDigEmpireMapGen, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("DigEmpire Map Generation"), STATGROUP_DigEmpireMapGen, STATCAT_Advanced);
+
+/** Measurements of one generation step. */
+struct FMapGenStepReport
+{
+    /** Step asset name and class */
+    FString StepName;
+    FString StepClass;
+
+    /** True if the step ran on the game thread */
+    bool bGameThread = false;
+
+    /** Wall-clock time of ExecuteGenerationStep */
+    double WallSeconds = 0.0;
+
+    /**
+     * Context scratch arena bytes in use at step end. Concurrent worker steps share the arena,
+     * so this counts their allocations too; per-allocation detail is under the DigEmpire/MapGen
+     * LLM tag (Insights memory trace).
+     */
+    int64 ScratchArenaBytes = 0;
+
+    /** Cell value changes made during the step (see UMapGrid2D::GetCellChangeCount); includes concurrent worker steps */
+    uint64 CellsMutated = 0;
+};
+
+/** Per-step report of one map build (see UMapGrid2DComponent::GetLastGenerationReport). */
+struct FMapGenReport
+{
+    FIntPoint MapSize = FIntPoint::ZeroValue;
+
+    /** Wall-clock time from build start to map ready */
+    double TotalSeconds = 0.0;
+
+    /** Executed steps in list order (skipped steps are not listed) */
+    TArray<FMapGenStepReport> Steps;
+
+    /** One line per step to LogDigEmpireMapGen. */
+    void Log() const;
+
+    /** Append one row per step to a CSV file (header written when the file is new). */
+    bool AppendToCsv(const FString& FilePath) const;
+};
+
+namespace MapGenReport
+{
+    /**
+     * Run one step against Context inside its trace/stat scopes and fill Out.
+     * Thread-safe as long as the step itself may run on the calling thread.
+     */
+    void ExecuteStep(const UMapGenerationStepDataBase* Step,
+                     FMapGenerationContext& Context,
+                     FMapGenStepReport& Out);
+}
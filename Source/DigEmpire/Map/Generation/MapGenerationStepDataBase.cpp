@@ -2,7 +2,7 @@
 
 #include "DigEmpire/Map/MapGrid2D.h"
 
-void UMapGenerationStepDataBase::ExecuteGenerationStep(UMapGrid2D* /*Map*/, UWorld* /*World*/, TArray<int32>& /*InOutZoneLabels*/) const
+void UMapGenerationStepDataBase::ExecuteGenerationStep(FMapGenerationContext& /*Context*/) const
 {
     // Default base does nothing.
 }
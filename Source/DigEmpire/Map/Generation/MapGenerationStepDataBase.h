@@ -6,6 +6,26 @@
 
 class UMapGrid2D;
 class UWorld;
+class FMapGenerationContext;
+
+/** Map data a generation step reads or writes; lets the pipeline run independent steps concurrently. */
+namespace EMapGenAccess
+{
+    enum Type : uint32
+    {
+        None       = 0,
+        ZoneLabels = 1 << 0, // FMapGenerationContext zone labels
+        Background = 1 << 1,
+        Objects    = 1 << 2, // object ids + durability (and the blocked bits / free lists derived from them)
+        Ore        = 1 << 3,
+        Zones      = 1 << 4, // zone plane and zone index
+        Passages   = 1 << 5,
+        Rooms      = 1 << 6,
+        ZoneDepths = 1 << 7,
+        Actors     = 1 << 8, // cell actor occupants
+        All        = (1 << 9) - 1
+    };
+}
 
 /**
  * Base data asset for a single map generation step.
@@ -16,6 +36,24 @@ class UMapGenerationStepDataBase : public UDataAsset
 {
     GENERATED_BODY()
 public:
-    /** Execute this generation step. Can read/update the map and zone labels. */
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const;
+    /**
+     * Execute this generation step against Context.GetMap(). Can read/replace the context's zone
+     * labels; step-local buffers should come from Context.GetScratch().
+     */
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const;
+
+    /**
+     * True if the step must run on the game thread (spawns actors, touches the world).
+     * Other steps may run on a worker thread against a private grid with World == nullptr,
+     * so they must only use the context's map, labels and scratch.
+     */
+    virtual bool RequiresGameThread() const { return false; }
+
+    /**
+     * EMapGenAccess bits this step reads / writes. Steps whose sets do not conflict may run
+     * concurrently; conflicting steps keep their list order. Must be exact supersets of what
+     * ExecuteGenerationStep touches. The default (All/All) keeps a step fully ordered.
+     */
+    virtual uint32 GetReadAccess() const { return EMapGenAccess::All; }
+    virtual uint32 GetWriteAccess() const { return EMapGenAccess::All; }
 };
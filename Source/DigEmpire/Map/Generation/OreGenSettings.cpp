@@ -1,13 +1,15 @@
 #include "OreGenSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "OreGenerator.h"
 
-void UOreGenSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void UOreGenSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() <= 0) return;
+    if (!Context.HasZoneLabels()) return;
     UOreGenerator* Gen = NewObject<UOreGenerator>();
-    Gen->Generate(Map, InOutZoneLabels, this);
+    Gen->Generate(Map, Context.GetZoneLabels(), this);
 }
 
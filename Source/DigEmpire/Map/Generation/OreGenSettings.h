@@ -42,6 +42,16 @@ struct FZoneOreConfig
     TArray<FOreCountRange> Ores;
 };
 
+/** How ore cells are distributed inside a zone. */
+UENUM(BlueprintType)
+enum class EOrePlacementMode : uint8
+{
+    /** Every ore cell is an independent random candidate */
+    Scatter,
+    /** Connected veins grown from blue-noise (Poisson-disk spaced) seeds */
+    Veins
+};
+
 /** Settings for placing ore on blocked tiles inside each zone. */
 UCLASS(BlueprintType)
 class UOreGenSettings : public UMapGenerationStepDataBase
@@ -56,10 +66,29 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ore")
     TArray<FGameplayTag> ForbiddenObjectTags;
 
+    /** Distribution of ore cells inside a zone. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ore")
+    EOrePlacementMode PlacementMode = EOrePlacementMode::Scatter;
+
+    /** Veins: minimum cells per vein. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ore|Veins", meta=(ClampMin="1"))
+    int32 MinVeinSize = 3;
+
+    /** Veins: maximum cells per vein (inclusive). */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ore|Veins", meta=(ClampMin="1"))
+    int32 MaxVeinSize = 8;
+
+    /** Veins: minimum distance between vein seeds in cells (relaxed once the zone runs out of room). */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ore|Veins", meta=(ClampMin="1.0"))
+    float VeinSpacing = 6.f;
+
     /** Random seed; if < 0 a random seed is used. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Random")
     int32 RandomSeed = -1;
 
     // Execute step: place ores per zone on blocked (object-occupied) tiles
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Objects; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::Ore; }
 };
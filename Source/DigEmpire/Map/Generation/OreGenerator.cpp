@@ -1,5 +1,7 @@
 #include "OreGenerator.h"
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
+#include "Async/ParallelFor.h"
 
 bool UOreGenerator::Generate(UMapGrid2D* MapGrid,
                              const TArray<int32>& ZoneLabels,
@@ -22,65 +24,225 @@ bool UOreGenerator::Generate(UMapGrid2D* MapGrid,
     int32 MaxZoneId = 0;
     for (int v : ZoneLabels) if (v > MaxZoneId) MaxZoneId = v;
 
-    // RNG
-    FRandomStream RNG(Settings->RandomSeed);
-    if (Settings->RandomSeed < 0) RNG.GenerateNewSeed();
+    // Zones in parallel, one stream each (see MapGenZones)
+    const uint32 BaseSeed = MapGenZones::MakeBaseSeed(Settings->RandomSeed);
 
-    // For each zone, collect candidate cells (object-occupied) and place ores
+    TArray<FZoneOre> Zones;
+    Zones.SetNum(MaxZoneId + 1);
     for (int32 ZoneId = 0; ZoneId <= MaxZoneId; ++ZoneId)
     {
         const FZoneOreConfig* ZoneCfg = ZoneIndexToConfig.FindRef(ZoneId);
         if (!ZoneCfg || ZoneCfg->Ores.Num() == 0) continue; // unspecified -> none
+        Zones[ZoneId].Config = ZoneCfg;
+        Zones[ZoneId].Box = FIntRect(W, H, -1, -1);
+    }
+
+    // Forbidden tags as palette ids: one bit test per cell instead of a tag search
+    const FMapTagMask ForbiddenMask = MapGrid->MakeTagMask(Settings->ForbiddenObjectTags);
+    const TMapGridPlane<uint16>& ObjectIds = MapGrid->GetObjectIdPlane();
+    const TMapGridPlane<int32>& Durability = MapGrid->GetDurabilityPlane();
 
-        TArray<FIntPoint> Candidates;
-        Candidates.Reserve(128);
-        // Collect tiles that are occupied by a block (object-level), ignore actors
-        for (int32 y = 0; y < H; ++y)
-        for (int32 x = 0; x < W; ++x)
+    // One pass buckets candidate cells (object-occupied, ignore actors) by zone.
+    // Row-major order is kept; spans of storage chunks known to be empty are skipped.
+    const FIntPoint NumChunks = MapGrid->GetNumChunks();
+    for (int32 y = 0; y < H; ++y)
+    for (int32 cx = 0; cx < NumChunks.X; ++cx)
+    {
+        const int32 cy = y / TMapGridPlane<int32>::ChunkSize;
+        if (MapGrid->IsChunkFreeOfObjects(cx, cy)) continue;
+        const FIntRect R = MapGrid->GetChunkRect(cx, cy);
+        for (int32 x = R.Min.X; x < R.Max.X; ++x)
         {
             const int32 id = Idx(x, y, W);
-            if (ZoneLabels[id] != ZoneId) continue;
-            FGameplayTag Obj; int32 Dur = 0;
-            if (MapGrid->GetObjectAt(x, y, Obj, Dur))
-            {
-                // Skip blocks explicitly forbidden for ore placement
-                if (Settings->ForbiddenObjectTags.Contains(Obj))
-                {
-                    continue;
-                }
-                // Has an object with durability => treat as a solid block
-                Candidates.Add(FIntPoint(x, y));
-            }
+            const int32 z = ZoneLabels[id];
+            if (z < 0 || !Zones[z].Config) continue;
+            // Has an object with durability => treat as a solid block, unless explicitly forbidden
+            if (Durability.Get(x, y) <= 0) continue;
+            if (ForbiddenMask.Contains(ObjectIds.Get(x, y))) continue;
+
+            FZoneOre& Z = Zones[z];
+            Z.Candidates.Add(id);
+            Z.Box.Min.X = FMath::Min(Z.Box.Min.X, x); Z.Box.Min.Y = FMath::Min(Z.Box.Min.Y, y);
+            Z.Box.Max.X = FMath::Max(Z.Box.Max.X, x + 1); Z.Box.Max.Y = FMath::Max(Z.Box.Max.Y, y + 1);
         }
+    }
 
-        if (Candidates.Num() == 0) continue;
+    ParallelFor(Zones.Num(), [&](int32 ZoneId)
+    {
+        FZoneOre& Z = Zones[ZoneId];
+        if (!Z.Config || Z.Candidates.Num() == 0) return;
+        FRandomStream ZoneRNG = MapGenZones::MakeZoneStream(BaseSeed, ZoneId);
+        if (Settings->PlacementMode == EOrePlacementMode::Veins)
+        {
+            PlaceVeins(Settings, W, ZoneRNG, Z);
+        }
+        else
+        {
+            PlaceScatter(ZoneRNG, Z);
+        }
+    });
 
-        // Shuffle candidate indices once; use sequentially for different ores to avoid overlap
-        TArray<int32> Idx;
-        Idx.SetNumUninitialized(Candidates.Num());
-        for (int32 i = 0; i < Candidates.Num(); ++i) Idx[i] = i;
-        for (int32 i = Idx.Num() - 1; i > 0; --i)
+    // Apply to the map
+    for (const FZoneOre& Z : Zones)
+    {
+        for (const TPair<int32, int32>& P : Z.Placed)
         {
-            const int32 j = RNG.RandRange(0, i);
-            if (i != j) Swap(Idx[i], Idx[j]);
+            MapGrid->SetOreAt(P.Key % W, P.Key / W, Z.Config->Ores[P.Value].OreTag);
         }
-        int32 Cursor = 0;
+    }
+
+    return true;
+}
+
+void UOreGenerator::PlaceScatter(FRandomStream& RNG, FZoneOre& Z) const
+{
+    // Shuffle candidate indices once; use sequentially for different ores to avoid overlap
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Z.Candidates.Num());
+    for (int32 i = 0; i < Z.Candidates.Num(); ++i) Order[i] = i;
+    for (int32 i = Order.Num() - 1; i > 0; --i)
+    {
+        const int32 j = RNG.RandRange(0, i);
+        if (i != j) Swap(Order[i], Order[j]);
+    }
+    int32 Cursor = 0;
 
-        for (const FOreCountRange& Ore : ZoneCfg->Ores)
+    const TArray<FOreCountRange>& Ores = Z.Config->Ores;
+    for (int32 OreIndex = 0; OreIndex < Ores.Num(); ++OreIndex)
+    {
+        const FOreCountRange& Ore = Ores[OreIndex];
+        if (!Ore.OreTag.IsValid()) continue;
+        const int32 MinC = FMath::Max(0, Ore.MinCount);
+        const int32 MaxC = FMath::Max(MinC, Ore.MaxCount);
+        const int32 Remaining = Order.Num() - Cursor;
+        if (Remaining <= 0) break;
+        const int32 Desired = FMath::Clamp(RNG.RandRange(MinC, MaxC), 0, Remaining);
+        for (int32 k = 0; k < Desired; ++k)
         {
-            if (!Ore.OreTag.IsValid()) continue;
-            const int32 MinC = FMath::Max(0, Ore.MinCount);
-            const int32 MaxC = FMath::Max(MinC, Ore.MaxCount);
-            const int32 Remaining = Idx.Num() - Cursor;
-            if (Remaining <= 0) break;
-            const int32 Desired = FMath::Clamp(RNG.RandRange(MinC, MaxC), 0, Remaining);
-            for (int32 k = 0; k < Desired; ++k)
+            Z.Placed.Emplace(Z.Candidates[Order[Cursor++]], OreIndex);
+        }
+    }
+}
+
+void UOreGenerator::PlaceVeins(const UOreGenSettings* Settings, int32 MapW, FRandomStream& RNG, FZoneOre& Z) const
+{
+    const int32 NumCand = Z.Candidates.Num();
+    const FIntRect& Box = Z.Box;
+    const int32 BW = Box.Width(), BH = Box.Height();
+
+    // Bounding-box cell -> candidate index (-1 = not eligible), for vein growth
+    TArray<int32> LocalToCand; LocalToCand.Init(-1, BW * BH);
+    for (int32 i = 0; i < NumCand; ++i)
+    {
+        const int32 id = Z.Candidates[i];
+        LocalToCand[(id % MapW - Box.Min.X) + (id / MapW - Box.Min.Y) * BW] = i;
+    }
+    TBitArray<> Used(false, NumCand);
+    int32 NumUsed = 0;
+
+    // Dart throwing over the candidates in one random order
+    TArray<int32> Order;
+    Order.SetNumUninitialized(NumCand);
+    for (int32 i = 0; i < NumCand; ++i) Order[i] = i;
+    for (int32 i = Order.Num() - 1; i > 0; --i)
+    {
+        const int32 j = RNG.RandRange(0, i);
+        if (i != j) Swap(Order[i], Order[j]);
+    }
+    int32 DartCursor = 0, FallbackCursor = 0;
+
+    // Poisson-disk acceptance grid: cells of Spacing/sqrt(2) hold at most one seed,
+    // so a conflicting seed is always within 2 grid cells
+    const float Spacing = FMath::Max(1.f, Settings->VeinSpacing);
+    const float GridCell = Spacing / UE_SQRT_2;
+    const int32 GW = FMath::Max(1, FMath::CeilToInt(BW / GridCell));
+    const int32 GH = FMath::Max(1, FMath::CeilToInt(BH / GridCell));
+    TArray<int32> SeedGrid; SeedGrid.Init(-1, GW * GH);
+    auto LocalOf = [&](int32 Cand) { const int32 id = Z.Candidates[Cand]; return FIntPoint(id % MapW - Box.Min.X, id / MapW - Box.Min.Y); };
+    auto GridOf = [&](const FIntPoint& L) { return FIntPoint(FMath::Min(GW - 1, int32(L.X / GridCell)), FMath::Min(GH - 1, int32(L.Y / GridCell))); };
+    auto IsFarFromSeeds = [&](int32 Cand)
+    {
+        const FIntPoint L = LocalOf(Cand);
+        const FIntPoint G = GridOf(L);
+        for (int32 gy = FMath::Max(0, G.Y - 2); gy <= FMath::Min(GH - 1, G.Y + 2); ++gy)
+        for (int32 gx = FMath::Max(0, G.X - 2); gx <= FMath::Min(GW - 1, G.X + 2); ++gx)
+        {
+            const int32 S = SeedGrid[gx + gy * GW];
+            if (S < 0) continue;
+            const FIntPoint D = LocalOf(S) - L;
+            if (float(D.X * D.X + D.Y * D.Y) < Spacing * Spacing) return false;
+        }
+        return true;
+    };
+
+    auto NextSeed = [&]() -> int32
+    {
+        while (DartCursor < NumCand)
+        {
+            const int32 c = Order[DartCursor++];
+            if (!Used[c] && IsFarFromSeeds(c)) return c;
+        }
+        // Out of spaced positions: relax spacing rather than placing less ore
+        while (FallbackCursor < NumCand)
+        {
+            const int32 c = Order[FallbackCursor++];
+            if (!Used[c]) return c;
+        }
+        return -1;
+    };
+
+    const int32 MinVein = FMath::Max(1, Settings->MinVeinSize);
+    const int32 MaxVein = FMath::Max(MinVein, Settings->MaxVeinSize);
+    TArray<int32> Frontier;
+
+    const TArray<FOreCountRange>& Ores = Z.Config->Ores;
+    for (int32 OreIndex = 0; OreIndex < Ores.Num(); ++OreIndex)
+    {
+        const FOreCountRange& Ore = Ores[OreIndex];
+        if (!Ore.OreTag.IsValid()) continue;
+        const int32 MinC = FMath::Max(0, Ore.MinCount);
+        const int32 MaxC = FMath::Max(MinC, Ore.MaxCount);
+        const int32 Remaining = NumCand - NumUsed;
+        if (Remaining <= 0) break;
+        const int32 Desired = FMath::Clamp(RNG.RandRange(MinC, MaxC), 0, Remaining);
+
+        auto Claim = [&](int32 c)
+        {
+            Used[c] = true; ++NumUsed;
+            Z.Placed.Emplace(Z.Candidates[c], OreIndex);
+            Frontier.Add(c);
+        };
+
+        int32 Count = 0;
+        while (Count < Desired)
+        {
+            const int32 Seed = NextSeed();
+            if (Seed < 0) break;
+            const FIntPoint G = GridOf(LocalOf(Seed));
+            if (SeedGrid[G.X + G.Y * GW] < 0) SeedGrid[G.X + G.Y * GW] = Seed;
+
+            // Grow the vein from random frontier cells through unused 4-neighbor candidates
+            const int32 VeinTarget = FMath::Min(RNG.RandRange(MinVein, MaxVein), Desired - Count);
+            Frontier.Reset();
+            Claim(Seed);
+            int32 Grown = 1;
+            while (Grown < VeinTarget && Frontier.Num() > 0)
             {
-                const FIntPoint& C = Candidates[Idx[Cursor++]];
-                MapGrid->SetOreAt(C.X, C.Y, Ore.OreTag);
+                const int32 f = RNG.RandRange(0, Frontier.Num() - 1);
+                const FIntPoint L = LocalOf(Frontier[f]);
+                int32 Free[4]; int32 NumFree = 0;
+                const FIntPoint N4[4] = { {L.X+1,L.Y},{L.X-1,L.Y},{L.X,L.Y+1},{L.X,L.Y-1} };
+                for (const FIntPoint& n : N4)
+                {
+                    if (n.X < 0 || n.Y < 0 || n.X >= BW || n.Y >= BH) continue;
+                    const int32 c = LocalToCand[n.X + n.Y * BW];
+                    if (c >= 0 && !Used[c]) Free[NumFree++] = c;
+                }
+                if (NumFree == 0) { Frontier.RemoveAtSwap(f, 1, EAllowShrinking::No); continue; }
+                Claim(Free[RNG.RandRange(0, NumFree - 1)]);
+                ++Grown;
             }
+            Count += Grown;
         }
     }
-
-    return true;
 }
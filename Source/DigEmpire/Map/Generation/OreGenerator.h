@@ -19,6 +19,21 @@ public:
                   const UOreGenSettings* Settings);
 
 private:
+    /** Ore-eligible cells of one zone and the ore chosen for them. */
+    struct FZoneOre
+    {
+        const FZoneOreConfig* Config = nullptr;
+        FIntRect Box;                        // bounds of the candidates (Max exclusive)
+        TArray<int32> Candidates;            // map cell ids, row-major
+        TArray<TPair<int32, int32>> Placed;  // (map cell id, index into Config->Ores)
+    };
+
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
+
+    /** Independent random candidates; ores take consecutive runs of one shuffle so they never overlap. */
+    void PlaceScatter(FRandomStream& RNG, FZoneOre& Zone) const;
+
+    /** Veins grown through 4-connected candidates from Poisson-disk spaced seeds. */
+    void PlaceVeins(const UOreGenSettings* Settings, int32 MapW, FRandomStream& RNG, FZoneOre& Zone) const;
 };
 
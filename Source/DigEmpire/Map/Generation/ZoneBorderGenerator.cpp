@@ -5,18 +5,22 @@ bool UZoneBorderGenerator::Generate(UMapGrid2D* MapGrid,
                                     const TArray<int32>& ZoneLabels,
                                     const UZoneBorderSettings* Settings)
 {
-    if (!ValidateInputs(MapGrid, ZoneLabels, Settings))
+    FMapGenerationContext Context(MapGrid, /*World*/ nullptr);
+    Context.SetZoneLabels(CopyTemp(ZoneLabels));
+    return Generate(Context, Settings);
+}
+
+bool UZoneBorderGenerator::Generate(FMapGenerationContext& Context, const UZoneBorderSettings* Settings)
+{
+    UMapGrid2D* MapGrid = Context.GetMap();
+    if (!ValidateInputs(MapGrid, Context.GetZoneLabels(), Settings))
         return false;
 
-    CachedLabels = ZoneLabels;
+    CachedLabels = Context.ShareZoneLabels();
     CachedSize = MapGrid->GetSize();
 
-    // Collect adjacent zone boundary seeds on the lower-id (A) and higher-id (B) sides
-    TMap<FIntPoint, TSet<FIntPoint>> PairToA, PairToB;
-    CollectZoneBoundaries(CachedLabels, PairToA, PairToB);
-
-    // Place walls along boundaries with configured thickness
-    PlaceWallsWithThickness(MapGrid, Settings, PairToA);
+    // Place walls along boundaries (on the lower-id side) with configured thickness
+    PlaceWallsWithThickness(MapGrid, Settings, Context.GetScratch());
 
     // Also place walls along the outer border of the map
     {
@@ -44,19 +48,30 @@ bool UZoneBorderGenerator::Generate(UMapGrid2D* MapGrid,
 TArray<FIntPoint> UZoneBorderGenerator::GetFreeCellsForZone(UMapGrid2D* MapGrid, int32 ZoneId) const
 {
     TArray<FIntPoint> Out;
-    if (!MapGrid || CachedLabels.Num() != CachedSize.X * CachedSize.Y) return Out;
+    if (!MapGrid || !CachedLabels || CachedLabels->Num() != CachedSize.X * CachedSize.Y) return Out;
     if (ZoneId < 0) return Out;
+    const TArray<int32>& Labels = *CachedLabels;
+
+    // Walk only this zone's cells when the grid index matches our labels
+    if (MapGrid->IsZoneIndexValid() && MapGrid->GetSize() == CachedSize)
+    {
+        for (const int32 id : MapGrid->GetZoneCellIndices(ZoneId))
+        {
+            if (Labels[id] != ZoneId) continue;
+            const FIntPoint C = MapGrid->IndexToCell(id);
+            if (MapGrid->HasObjectAt(C.X, C.Y)) continue;
+            Out.Add(C);
+        }
+        return Out;
+    }
 
     const int32 W = CachedSize.X, H = CachedSize.Y;
     for (int32 y = 0; y < H; ++y)
     for (int32 x = 0; x < W; ++x)
     {
         const int32 id = Idx(x,y,W);
-        if (CachedLabels[id] != ZoneId) continue;
-
-        FGameplayTag Obj; int32 Durability = 0;
-        const bool bHasObj = MapGrid->GetObjectAt(x, y, Obj, Durability);
-        if (bHasObj && Obj.IsValid() && Durability > 0) continue;
+        if (Labels[id] != ZoneId) continue;
+        if (MapGrid->HasObjectAt(x, y)) continue;
         Out.Add(FIntPoint(x,y));
     }
     return Out;
@@ -75,101 +90,54 @@ bool UZoneBorderGenerator::ValidateInputs(const UMapGrid2D* Map,
     return true;
 }
 
-void UZoneBorderGenerator::CollectZoneBoundaries(const TArray<int32>& Labels,
-                                                 TMap<FIntPoint, TSet<FIntPoint>>& OutPairToA,
-                                                 TMap<FIntPoint, TSet<FIntPoint>>& OutPairToB) const
+void UZoneBorderGenerator::PlaceWallsWithThickness(UMapGrid2D* Map,
+                                                   const UZoneBorderSettings* Settings,
+                                                   FMapGenScratchArena& Scratch) const
 {
     const int32 W = CachedSize.X, H = CachedSize.Y;
-    auto PairKey = [](int32 A, int32 B)->FIntPoint { return (A < B) ? FIntPoint(A,B) : FIntPoint(B,A); };
+    const TArray<int32>& Labels = *CachedLabels;
+    const int32 Rings = Settings->BorderThickness - 1;
 
+    // Seeds: cells with a 4-neighbor in a higher-id zone (the lower-id side of each boundary)
+    TArrayView<int32> Dist = Scratch.Alloc<int32>(W * H, INT32_MAX);
+    TArrayView<int32> Queue = Scratch.Alloc<int32>(W * H); // each cell is queued at most once
+    int32 QueueNum = 0;
     for (int32 y = 0; y < H; ++y)
     for (int32 x = 0; x < W; ++x)
     {
-        const int32 z = Labels[Idx(x,y,W)];
+        const int32 id = Idx(x,y,W);
+        const int32 z = Labels[id];
         if (z < 0) continue;
-        // Right neighbor
-        if (x < W - 1)
-        {
-            const int32 z2 = Labels[Idx(x+1,y,W)];
-            if (z2 >= 0 && z2 != z)
-            {
-                const FIntPoint Key = PairKey(z, z2);
-                if (Key.X == z)  { OutPairToA.FindOrAdd(Key).Add(FIntPoint(x,   y)); }
-                else             { OutPairToA.FindOrAdd(Key).Add(FIntPoint(x+1, y)); }
-                if (Key.Y == z)  { OutPairToB.FindOrAdd(Key).Add(FIntPoint(x,   y)); }
-                else             { OutPairToB.FindOrAdd(Key).Add(FIntPoint(x+1, y)); }
-            }
-        }
-        // Up neighbor
-        if (y < H - 1)
-        {
-            const int32 z2 = Labels[Idx(x,y+1,W)];
-            if (z2 >= 0 && z2 != z)
-            {
-                const FIntPoint Key = PairKey(z, z2);
-                if (Key.X == z)  { OutPairToA.FindOrAdd(Key).Add(FIntPoint(x, y  )); }
-                else             { OutPairToA.FindOrAdd(Key).Add(FIntPoint(x, y+1)); }
-                if (Key.Y == z)  { OutPairToB.FindOrAdd(Key).Add(FIntPoint(x, y  )); }
-                else             { OutPairToB.FindOrAdd(Key).Add(FIntPoint(x, y+1)); }
-            }
-        }
+        const bool bSeed = (x > 0     && Labels[id-1] > z) || (x < W - 1 && Labels[id+1] > z)
+                        || (y > 0     && Labels[id-W] > z) || (y < H - 1 && Labels[id+W] > z);
+        if (!bSeed) continue;
+        Dist[id] = 0;
+        Queue[QueueNum++] = id;
     }
-}
 
-void UZoneBorderGenerator::PlaceWallsWithThickness(UMapGrid2D* Map,
-                                                   const UZoneBorderSettings* Settings,
-                                                   const TMap<FIntPoint, TSet<FIntPoint>>& PairToA)
-{
-    for (const auto& kv : PairToA)
+    // Multi-source BFS that never leaves the seed's zone; each cell is queued at most once
+    for (int32 Head = 0; Head < QueueNum; ++Head)
     {
-        const FIntPoint Key = kv.Key; // (ZoneA, ZoneB)
-        const TSet<FIntPoint>& ASeeds = kv.Value;
-
-        TSet<FIntPoint> AExpanded;
-        ExpandInwardWithinZone(ASeeds, Key.X, Settings->BorderThickness - 1, AExpanded);
-
-        TSet<FIntPoint> ToWall = ASeeds;
-        for (const FIntPoint& p : AExpanded) ToWall.Add(p);
-
-        for (const FIntPoint& p : ToWall)
+        const int32 id = Queue[Head];
+        if (Dist[id] >= Rings) continue;
+        const int32 x = id % W, y = id / W;
+        const int32 z = Labels[id];
+        auto Visit = [&](int32 nid)
         {
-            PutWall(Map, p.X, p.Y, Settings);
-        }
+            if (Labels[nid] != z || Dist[nid] != INT32_MAX) return; // stay inside the zone
+            Dist[nid] = Dist[id] + 1;
+            Queue[QueueNum++] = nid;
+        };
+        if (x > 0)     Visit(id - 1);
+        if (x < W - 1) Visit(id + 1);
+        if (y > 0)     Visit(id - W);
+        if (y < H - 1) Visit(id + W);
     }
-}
 
-void UZoneBorderGenerator::ExpandInwardWithinZone(const TSet<FIntPoint>& Seeds,
-                                                  int32 ZoneId,
-                                                  int32 Rings,
-                                                  TSet<FIntPoint>& OutExpanded) const
-{
-    if (Rings <= 0 || Seeds.Num() == 0) return;
-
-    const int32 W = CachedSize.X, H = CachedSize.Y;
-    TSet<FIntPoint> Current = Seeds;
-    TSet<FIntPoint> Visited = Seeds;
-
-    for (int32 r = 0; r < Rings; ++r)
+    // Write the walls in one row-major sweep
+    for (int32 id = 0; id < W * H; ++id)
     {
-        TSet<FIntPoint> Next;
-        for (const FIntPoint& c : Current)
-        {
-            const FIntPoint N4[4] = { {c.X+1,c.Y},{c.X-1,c.Y},{c.X,c.Y+1},{c.X,c.Y-1} };
-            for (const FIntPoint& n : N4)
-            {
-                if (n.X < 0 || n.Y < 0 || n.X >= W || n.Y >= H) continue;
-                if (Visited.Contains(n)) continue;
-
-                const int32 lab = CachedLabels[Idx(n.X,n.Y,W)];
-                if (lab != ZoneId) continue;              // stay inside the zone
-
-                Visited.Add(n);
-                Next.Add(n);
-            }
-        }
-        for (const FIntPoint& v : Next) OutExpanded.Add(v);
-        Current = MoveTemp(Next);
-        if (Current.Num() == 0) break;
+        if (Dist[id] != INT32_MAX) PutWall(Map, id % W, id / W, Settings);
     }
 }
 
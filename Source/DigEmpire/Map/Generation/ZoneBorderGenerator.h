@@ -4,6 +4,7 @@
 #include "UObject/Object.h"
 #include "ZoneBorderSettings.h"
 #include "ZonePassageTypes.h"
+#include "MapGenerationContext.h"
 #include "ZoneBorderGenerator.generated.h"
 
 class UMapGrid2D;
@@ -19,12 +20,15 @@ public:
                   const TArray<int32>& ZoneLabels,
                   const UZoneBorderSettings* Settings);
 
+    /** Generate against a step context: the labels are shared instead of copied, scratch comes from its arena. */
+    bool Generate(FMapGenerationContext& Context, const UZoneBorderSettings* Settings);
+
     /** Returns FREE (no-object) cells of a single zone. */
     UFUNCTION(BlueprintPure, Category="ZoneBorders|Query")
     TArray<FIntPoint> GetFreeCellsForZone(UMapGrid2D* MapGrid, int32 ZoneId) const;
 
 private:
-    UPROPERTY(Transient) TArray<int32> CachedLabels;
+    TSharedPtr<const TArray<int32>, ESPMode::ThreadSafe> CachedLabels;
     UPROPERTY(Transient) FIntPoint CachedSize = FIntPoint::ZeroValue;
 
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
@@ -32,18 +36,13 @@ private:
 
     bool ValidateInputs(const UMapGrid2D* Map, const TArray<int32>& Labels, const UZoneBorderSettings* Settings) const;
 
-    void CollectZoneBoundaries(const TArray<int32>& Labels,
-                               TMap<FIntPoint, TSet<FIntPoint>>& OutPairToA,
-                               TMap<FIntPoint, TSet<FIntPoint>>& OutPairToB) const;
-
+    /**
+     * Wall every cell within BorderThickness-1 steps (city-block, inside its own zone) of a cell
+     * that touches a higher-id zone: one multi-source BFS over the label grid, then one write sweep.
+     */
     void PlaceWallsWithThickness(UMapGrid2D* Map,
                                  const UZoneBorderSettings* Settings,
-                                 const TMap<FIntPoint, TSet<FIntPoint>>& PairToA);
-
-    void ExpandInwardWithinZone(const TSet<FIntPoint>& Seeds,
-                                int32 ZoneId,
-                                int32 Rings,
-                                TSet<FIntPoint>& OutExpanded) const;
+                                 FMapGenScratchArena& Scratch) const;
 
     /** Map utilities */
     void PutWall(UMapGrid2D* Map, int32 X, int32 Y, const UZoneBorderSettings* Settings) const;
@@ -1,23 +1,25 @@
 #include "ZoneBorderSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "ZoneBorderGenerator.h"
 #include "ZonePassageGenerator.h"
 
-void UZoneBorderSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void UZoneBorderSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() <= 0)
+    if (!Context.HasZoneLabels())
     {
         // Requires zone labels from a previous step
         return;
     }
 
     UZoneBorderGenerator* BorderGen = NewObject<UZoneBorderGenerator>();
-    if (BorderGen->Generate(Map, InOutZoneLabels, this))
+    if (BorderGen->Generate(Context, this))
     {
         UZonePassageGenerator* PassageGen = NewObject<UZonePassageGenerator>();
-        if (PassageGen->Generate(Map, InOutZoneLabels, this))
+        if (PassageGen->Generate(Context, this))
         {
             Map->SetPassages(PassageGen->GetPassages());
         }
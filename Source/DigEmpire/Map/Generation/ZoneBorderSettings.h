@@ -80,5 +80,8 @@ public:
     float DebugLifetime = 5.f;
 
     // Execute step: place walls on zone borders and carve passages
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Zones | EMapGenAccess::Objects; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::Objects | EMapGenAccess::Passages; }
 };
@@ -1,6 +1,65 @@
 #include "ZoneConnectivityFixer.h"
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /** Growable ring-buffer deque of cell ids: O(1) push at both ends and pop at the front (0-1 BFS). */
+    class FCellDeque
+    {
+    public:
+        explicit FCellDeque(int32 InitialCapacity)
+        {
+            const int32 Capacity = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(16, InitialCapacity));
+            Data.SetNumUninitialized(Capacity);
+            Mask = Capacity - 1;
+        }
+
+        bool IsEmpty() const { return Count == 0; }
+
+        void PushFront(int32 Id)
+        {
+            GrowIfFull();
+            Head = (Head - 1) & Mask;
+            Data[Head] = Id;
+            ++Count;
+        }
+
+        void PushBack(int32 Id)
+        {
+            GrowIfFull();
+            Data[(Head + Count) & Mask] = Id;
+            ++Count;
+        }
+
+        int32 PopFront()
+        {
+            const int32 Id = Data[Head];
+            Head = (Head + 1) & Mask;
+            --Count;
+            return Id;
+        }
+
+    private:
+        void GrowIfFull()
+        {
+            if (Count < Data.Num()) return;
+            TArray<int32> Grown;
+            Grown.SetNumUninitialized(Data.Num() * 2);
+            for (int32 i = 0; i < Count; ++i) Grown[i] = Data[(Head + i) & Mask];
+            Data = MoveTemp(Grown);
+            Head = 0;
+            Mask = Data.Num() - 1;
+        }
+
+        TArray<int32> Data;
+        int32 Head = 0;
+        int32 Count = 0;
+        int32 Mask = 0;
+    };
+}
 
 bool UZoneConnectivityFixer::Generate(UMapGrid2D* MapGrid,
                                       const TArray<int32>& ZoneLabels,
@@ -11,171 +70,251 @@ bool UZoneConnectivityFixer::Generate(UMapGrid2D* MapGrid,
                                       float DebugSphereRadiusUU,
                                       float DebugLifetime)
 {
+    FMapGenerationContext Context(MapGrid, /*World*/ nullptr);
+    Context.SetZoneLabels(CopyTemp(ZoneLabels));
+    return Generate(Context, ImmutableObjectTags, bDebugDraw, DebugTileSizeUU, DebugZOffset, DebugSphereRadiusUU, DebugLifetime);
+}
+
+bool UZoneConnectivityFixer::Generate(FMapGenerationContext& Context,
+                                      const TArray<FGameplayTag>& ImmutableObjectTags,
+                                      bool bDebugDraw,
+                                      float DebugTileSizeUU,
+                                      float DebugZOffset,
+                                      float DebugSphereRadiusUU,
+                                      float DebugLifetime)
+{
+    UMapGrid2D* MapGrid = Context.GetMap();
     if (!MapGrid) return false;
     const FIntPoint Size = MapGrid->GetSize();
     const int32 W = Size.X, H = Size.Y;
     if (W <= 0 || H <= 0) return false;
+    const TArray<int32>& ZoneLabels = Context.GetZoneLabels();
     if (ZoneLabels.Num() != W * H) return false;
 
-    // Determine max zone id
-    int32 MaxZoneId = 0; for (int v : ZoneLabels) if (v > MaxZoneId) MaxZoneId = v;
+    const TConstArrayView<FIntRect> ZoneBounds = Context.GetZoneBounds();
+    const int32 NumZones = ZoneBounds.Num();
+    if (NumZones <= 0) return true;
+
+    TArray<FZoneLinks> Zones;
+    Zones.SetNum(NumZones);
+    for (int32 z = 0; z < NumZones; ++z) Zones[z].Box = ZoneBounds[z];
 
-    TArray<uint8> Open, ImmWall, MutWall;
-    Open.SetNumZeroed(W * H);
-    ImmWall.SetNumZeroed(W * H);
-    MutWall.SetNumZeroed(W * H);
+    // Force-free the cell directly outside each room entrance within the same zone.
+    // This guarantees the room has an exit into traversable space. Done up front so
+    // the per-zone passes below only read the map.
+    for (const FRoomInfo& R : MapGrid->GetRooms())
+    {
+        const int x0=R.TopLeft.X, y0=R.TopLeft.Y, w=R.Size.X, h=R.Size.Y;
+        FIntPoint Outside = R.Entrance;
+        if (R.Entrance.Y == y0)            { Outside.Y -= 1; }           // entrance on top edge -> outside north
+        else if (R.Entrance.Y == y0 + h - 1) { Outside.Y += 1; }         // bottom edge -> outside south
+        else if (R.Entrance.X == x0)       { Outside.X -= 1; }           // left edge -> outside west
+        else if (R.Entrance.X == x0 + w - 1) { Outside.X += 1; }         // right edge -> outside east
+
+        if (!MapGrid->IsInBounds(Outside.X, Outside.Y)) continue;
+        if (ZoneLabels[Idx(Outside.X, Outside.Y, W)] != R.ZoneId) continue;
+        if (MapGrid->HasObjectAt(Outside.X, Outside.Y))
+        {
+            MapGrid->RemoveObjectAt(Outside.X, Outside.Y);
+        }
+    }
 
-    // Temporary arrays for component labels
-    TArray<int32> Comp; Comp.Init(-1, W*H);
-    TArray<FNode> Q; Q.Reserve(W*H);
+    // Immutable tags as palette ids: one bit test per cell instead of a tag search
+    const FMapTagMask ImmutableMask = MapGrid->MakeTagMask(ImmutableObjectTags);
 
+    // Zones in parallel (see MapGenZones); carving is deferred
+    ParallelFor(NumZones, [&](int32 ZoneId)
+    {
+        FZoneLinks& Z = Zones[ZoneId];
+        if (Z.Box.IsEmpty()) return; // no cells
+        BuildMasksForZone(MapGrid, ZoneLabels, ZoneId, ImmutableMask, Z);
+        LabelComponents(Z);
+        if (Z.NumComps > 1) LinkComponents(Z);
+    });
+
+    // Apply carves
+    for (const FZoneLinks& Z : Zones)
+    {
+        for (const FIntPoint& C : Z.Carve)
+        {
+            MapGrid->RemoveObjectAt(C.X, C.Y);
+        }
+    }
+
+    // Debug draw all open cells that remain in unconnected components
     UWorld* World = MapGrid->GetWorld();
-    for (int32 ZoneId = 0; ZoneId <= MaxZoneId; ++ZoneId)
+    if (bDebugDraw && World)
     {
-        // Build masks for this zone
-        Open.Init(0, W*H); ImmWall.Init(0, W*H); MutWall.Init(0, W*H); Comp.Init(-1, W*H);
-        BuildMasksForZone(MapGrid, ZoneLabels, ZoneId, ImmutableObjectTags, Open, ImmWall, MutWall);
-
-        // Label connected components among open cells (4-neighbors)
-        int32 compCount = 0;
-        TArray<int32> compSizes;
-        for (int32 y = 0; y < H; ++y)
-        for (int32 x = 0; x < W; ++x)
+        for (const FZoneLinks& Z : Zones)
         {
-            const int id = Idx(x,y,W);
-            if (ZoneLabels[id] != ZoneId) continue;
-            if (!Open[id]) continue;
-            if (Comp[id] != -1) continue;
-
-            const int curComp = compCount++;
-            int32 size = 0;
-            Q.Reset(); Q.Add({(int16)x,(int16)y}); Comp[id] = curComp;
-            while (!Q.IsEmpty())
+            if (Z.NumComps <= 1) continue;
+            const int32 BW = Z.Box.Width();
+            for (int32 id = 0; id < Z.Comp.Num(); ++id)
             {
-                const FNode n = Q.Pop(EAllowShrinking::No);
-                ++size;
-                const int nid = Idx(n.X, n.Y, W);
-                // 4-neighbors
-                auto Push = [&](int nx, int ny){
-                    if (nx<0||ny<0||nx>=W||ny>=H) return;
-                    const int iid = Idx(nx,ny,W);
-                    if (ZoneLabels[iid]!=ZoneId) return;
-                    if (!Open[iid]) return;
-                    if (Comp[iid]!=-1) return;
-                    Comp[iid]=curComp; Q.Add({(int16)nx,(int16)ny});
-                };
-                Push(n.X+1,n.Y); Push(n.X-1,n.Y); Push(n.X,n.Y+1); Push(n.X,n.Y-1);
+                const int c = Z.Comp[id];
+                if (c < 0 || Z.CompLinked[c]) continue;
+                const int x = Z.Box.Min.X + id % BW, y = Z.Box.Min.Y + id / BW;
+                const FVector P(x * DebugTileSizeUU, y * DebugTileSizeUU, DebugZOffset);
+                DrawDebugSphere(World, P, DebugSphereRadiusUU, 12, FColor::Red, DebugLifetime <= 0.f, DebugLifetime);
             }
-            compSizes.Add(size);
         }
+    }
 
-        if (compCount <= 1) continue; // already connected or empty
-
-        // Pick largest component as main
-        int32 mainComp = 0; int32 bestSize = -1;
-        for (int32 i=0;i<compSizes.Num();++i){ if (compSizes[i]>bestSize){bestSize=compSizes[i]; mainComp=i;} }
-        TArray<uint8> compConnected; compConnected.Init(0, compCount); compConnected[mainComp]=1;
+    return true;
+}
 
-        // Multi-source 0-1 BFS to connect remaining components iteratively
-        TArray<int32> Dist; Dist.Init(INT32_MAX, W*H);
-        TArray<int32> Prev; Prev.Init(-1, W*H);
-        TArray<uint8> InQueue; InQueue.Init(0, W*H);
+void UZoneConnectivityFixer::LabelComponents(FZoneLinks& Z) const
+{
+    const int32 BW = Z.Box.Width(), BH = Z.Box.Height();
+    const int32 N = BW * BH;
+
+    // Label connected components among open cells (4-neighbors)
+    Z.Comp.Init(-1, N);
+    Z.NumComps = 0;
+    TArray<int32> CompSizes;
+    TArray<int32> Stack; Stack.Reserve(N);
+    for (int32 id = 0; id < N; ++id)
+    {
+        if (Z.Cells[id] != FZoneLinks::Open || Z.Comp[id] != -1) continue;
 
-        auto ConnectOne = [&]() -> bool
+        const int32 curComp = Z.NumComps++;
+        int32 size = 0;
+        Stack.Reset(); Stack.Add(id); Z.Comp[id] = curComp;
+        while (!Stack.IsEmpty())
         {
-            // Initialize deque with all cells of connected components
-            TArray<int32> Deque; Deque.Reserve(W*H);
-            auto PushFront = [&](int id){ Deque.Insert(id,0); };
-            auto PushBack  = [&](int id){ Deque.Add(id); };
-            auto PopFront  = [&](){ int id=Deque[0]; Deque.RemoveAt(0); return id; };
+            const int32 n = Stack.Pop(EAllowShrinking::No);
+            ++size;
+            const int32 x = n % BW, y = n / BW;
+            auto Push = [&](int32 nx, int32 ny){
+                if (nx<0||ny<0||nx>=BW||ny>=BH) return;
+                const int32 nid = Idx(nx,ny,BW);
+                if (Z.Cells[nid] != FZoneLinks::Open || Z.Comp[nid] != -1) return;
+                Z.Comp[nid] = curComp; Stack.Add(nid);
+            };
+            Push(x+1,y); Push(x-1,y); Push(x,y+1); Push(x,y-1);
+        }
+        CompSizes.Add(size);
+    }
 
-            for (int32 i=0;i<W*H;++i){ Dist[i]=INT32_MAX; Prev[i]=-1; InQueue[i]=0; }
+    // Components count as linked once joined to the largest one
+    Z.CompLinked.Init(Z.NumComps <= 1 ? 1 : 0, Z.NumComps);
+    if (Z.NumComps > 1)
+    {
+        int32 mainComp = 0;
+        for (int32 i = 1; i < CompSizes.Num(); ++i) if (CompSizes[i] > CompSizes[mainComp]) mainComp = i;
+        Z.CompLinked[mainComp] = 1;
+    }
+}
 
-            for (int32 i=0;i<W*H;++i)
-            {
-                if (ZoneLabels[i]!=ZoneId) continue;
-                if (!Open[i]) continue;
-                if (Comp[i]>=0 && compConnected[Comp[i]])
-                {
-                    Dist[i]=0; InQueue[i]=1; PushFront(i);
-                }
-            }
-            if (Deque.Num()==0) return false;
+void UZoneConnectivityFixer::LinkComponents(FZoneLinks& Z) const
+{
+    const int32 BW = Z.Box.Width(), BH = Z.Box.Height();
+    const int32 N = BW * BH;
+
+    // Multi-source 0-1 BFS from every open cell at once: each reachable cell learns the
+    // component closest to it (Owner), the walls to carve to get there (Dist) and the way back (Prev).
+    // Entering an open cell costs 0, a mutable wall 1; blocked cells are never entered.
+    TArray<int32> Dist; Dist.Init(INT32_MAX, N);
+    TArray<int32> Prev; Prev.Init(-1, N);
+    TArray<int32> Owner; Owner.Init(-1, N);
+    TBitArray<> Done(false, N);
+    FCellDeque Deque(N);
+
+    for (int32 id = 0; id < N; ++id)
+    {
+        if (Z.Comp[id] < 0) continue;
+        Dist[id] = 0; Owner[id] = Z.Comp[id];
+        Deque.PushBack(id);
+    }
 
-            int32 meetId = -1; int32 meetComp = -1;
-            while (Deque.Num()>0)
+    while (!Deque.IsEmpty())
+    {
+        const int32 id = Deque.PopFront();
+        if (Done[id]) continue; // stale entry, already settled with a lower distance
+        Done[id] = true;
+        const int32 x = id % BW, y = id / BW;
+
+        auto Relax = [&](int32 nx, int32 ny){
+            if (nx<0||ny<0||nx>=BW||ny>=BH) return;
+            const int32 nid = Idx(nx,ny,BW);
+            const uint8 Kind = Z.Cells[nid];
+            if (Kind == FZoneLinks::Blocked) return; // cannot cross immutable walls
+            const int32 w = Kind == FZoneLinks::MutableWall ? 1 : 0;
+            const int32 nd = Dist[id] + w;
+            if (nd < Dist[nid])
             {
-                const int id = PopFront(); InQueue[id]=0;
-                const int x = id % W; const int y = id / W;
-
-                // If we reached an unconnected component, stop
-                if (Comp[id]>=0 && !compConnected[Comp[id]]) { meetId=id; meetComp=Comp[id]; break; }
-
-                auto Relax = [&](int nx, int ny){
-                    if (nx<0||ny<0||nx>=W||ny>=H) return;
-                    const int nid = Idx(nx,ny,W);
-                    if (ZoneLabels[nid]!=ZoneId) return;
-                    if (ImmWall[nid]) return; // cannot cross immutable walls
-                    const int w = MutWall[nid] ? 1 : (Open[nid] ? 0 : 1); // non-open but mutable treated as wall cost 1
-                    const int nd = Dist[id] + w;
-                    if (nd < Dist[nid])
-                    {
-                        Dist[nid]=nd; Prev[nid]=id;
-                        if (w==0) { Deque.Insert(nid,0); }
-                        else { Deque.Add(nid); }
-                    }
-                };
-                Relax(x+1,y); Relax(x-1,y); Relax(x,y+1); Relax(x,y-1);
+                Dist[nid] = nd; Prev[nid] = id; Owner[nid] = Owner[id];
+                if (w == 0) Deque.PushFront(nid); else Deque.PushBack(nid);
             }
+        };
+        Relax(x+1,y); Relax(x-1,y); Relax(x,y+1); Relax(x,y-1);
+    }
 
-            if (meetId<0 || meetComp<0) return false;
-
-            // Reconstruct and carve along path where MutWall==1 or (not open and not immutable)
-            int cur = meetId;
-            while (cur>=0 && Prev[cur]>=0)
-            {
-                if (MutWall[cur])
-                {
-                    const int cx = cur % W; const int cy = cur / W;
-                    MapGrid->RemoveObjectAt(cx, cy);
-                    Open[cur]=1; MutWall[cur]=0;
-                }
-                cur = Prev[cur];
-            }
+    // Cheapest link between every pair of neighboring regions: walls carved on both sides
+    struct FLink { int32 Cost; int32 A; int32 B; };
+    TMap<uint64, FLink> BestLinks;
+    auto Consider = [&](int32 a, int32 b)
+    {
+        if (Owner[a] < 0 || Owner[b] < 0 || Owner[a] == Owner[b]) return;
+        const int32 Lo = FMath::Min(Owner[a], Owner[b]), Hi = FMath::Max(Owner[a], Owner[b]);
+        const uint64 Key = (uint64(Lo) << 32) | uint32(Hi);
+        const int32 Cost = Dist[a] + Dist[b];
+        FLink* Existing = BestLinks.Find(Key);
+        if (!Existing) BestLinks.Add(Key, FLink{ Cost, a, b });
+        else if (Cost < Existing->Cost) *Existing = FLink{ Cost, a, b };
+    };
+    for (int32 y = 0; y < BH; ++y)
+    for (int32 x = 0; x < BW; ++x)
+    {
+        const int32 id = Idx(x,y,BW);
+        if (x + 1 < BW) Consider(id, id + 1);
+        if (y + 1 < BH) Consider(id, id + BW);
+    }
 
-            // Mark this component connected
-            compConnected[meetComp]=1;
-            return true;
-        };
+    TArray<FLink> Links;
+    BestLinks.GenerateValueArray(Links);
+    Links.Sort([](const FLink& L, const FLink& R)
+    {
+        if (L.Cost != R.Cost) return L.Cost < R.Cost;
+        return L.A != R.A ? L.A < R.A : L.B < R.B; // deterministic order for equal costs
+    });
+
+    // Kruskal over components; each accepted link carves its two halves back to their owners
+    TArray<int32> Parent; Parent.SetNumUninitialized(Z.NumComps);
+    for (int32 i = 0; i < Z.NumComps; ++i) Parent[i] = i;
+    auto Find = [&](int32 c)
+    {
+        while (Parent[c] != c) { Parent[c] = Parent[Parent[c]]; c = Parent[c]; }
+        return c;
+    };
 
-        // Connect until all components connected or no path
-        int remaining = compCount - 1;
-        while (remaining>0)
+    auto CarvePath = [&](int32 cur)
+    {
+        for (; cur >= 0; cur = Prev[cur])
         {
-            if (!ConnectOne()) break;
-            remaining = 0; for (int i=0;i<compCount;++i) if (!compConnected[i]) ++remaining;
+            if (Z.Cells[cur] != FZoneLinks::MutableWall) continue;
+            Z.Cells[cur] = FZoneLinks::Open;
+            Z.Carve.Add(FIntPoint(Z.Box.Min.X + cur % BW, Z.Box.Min.Y + cur / BW));
         }
+    };
 
-        // Debug draw all open cells that remain in unconnected components
-        if (bDebugDraw && World)
-        {
-            for (int32 y = 0; y < H; ++y)
-            for (int32 x = 0; x < W; ++x)
-            {
-                const int id = Idx(x, y, W);
-                if (!Open[id]) continue;
-                const int c = Comp[id];
-                // Draw if component index is invalid or not connected
-                if (c < 0 || !compConnected.IsValidIndex(c) || !compConnected[c])
-                {
-                    const FVector P(x * DebugTileSizeUU, y * DebugTileSizeUU, DebugZOffset);
-                   DrawDebugSphere(World, P, DebugSphereRadiusUU, 12, FColor::Red, DebugLifetime <= 0.f, DebugLifetime);
-                } 
-            }
-        }
+    int32 Joins = 0;
+    for (const FLink& L : Links)
+    {
+        const int32 RA = Find(Owner[L.A]), RB = Find(Owner[L.B]);
+        if (RA == RB) continue;
+        Parent[RA] = RB;
+        CarvePath(L.A);
+        CarvePath(L.B);
+        if (++Joins == Z.NumComps - 1) break;
     }
 
-    return true;
+    // Components separated by immutable walls stay unlinked
+    const int32 MainRoot = Find(Z.CompLinked.IndexOfByKey(1));
+    for (int32 c = 0; c < Z.NumComps; ++c)
+    {
+        Z.CompLinked[c] = Find(c) == MainRoot ? 1 : 0;
+    }
 }
 
 bool UZoneConnectivityFixer::IsZoneConnected(const UMapGrid2D* MapGrid,
@@ -193,8 +332,7 @@ bool UZoneConnectivityFixer::IsZoneConnected(const UMapGrid2D* MapGrid,
         if (x<0||y<0||x>=W||y>=H) return false;
         const int id = Idx(x,y,W);
         if (MapGrid->GetZoneAt(x, y) != ZoneId) return false;
-        FGameplayTag T; int32 D=0; 
-        if (!MapGrid->GetObjectAt(x,y,T,D)) return true; // no wall
+        if (!MapGrid->HasObjectAt(x,y)) return true; // no wall
         // If it's a passage cell, treat as open even if object existed (shouldn't normally)
         for (const FZonePassage& P : Passages)
         {
@@ -237,101 +375,41 @@ bool UZoneConnectivityFixer::IsZoneConnected(const UMapGrid2D* MapGrid,
     return true;
 }
 
-void UZoneConnectivityFixer::BuildMasksForZone(UMapGrid2D* Map,
+void UZoneConnectivityFixer::BuildMasksForZone(const UMapGrid2D* Map,
                                                const TArray<int32>& Labels,
                                                int32 ZoneId,
-                                               const TArray<FGameplayTag>& ImmutableObjectTags,
-                                               TArray<uint8>& Open,
-                                               TArray<uint8>& ImmWall,
-                                               TArray<uint8>& MutWall)
+                                               const FMapTagMask& ImmutableMask,
+                                               FZoneLinks& Z) const
 {
-    const FIntPoint Size = Map->GetSize();
-    const int32 W = Size.X, H = Size.Y;
-    const TArray<FRoomInfo>& Rooms = Map->GetRooms();
-    const TArray<FZonePassage>& Passages = Map->GetPassages();
+    const int32 W = Map->GetSize().X;
+    const FIntRect& Box = Z.Box;
+    const int32 BW = Box.Width();
+    auto Local = [&](int32 X, int32 Y) { return Idx(X - Box.Min.X, Y - Box.Min.Y, BW); };
 
-    TSet<FIntPoint> RoomInterior; // treat as non-traversable for connectivity (immutable block)
-    TSet<FIntPoint> RoomWalls;
+    // Outside the zone counts as wall
+    Z.Cells.Init(FZoneLinks::Blocked, BW * Box.Height());
 
-    // Rooms: interiors NON-TRAVERSABLE; walls immutable wall; entrance is also non-traversable here
-    for (const FRoomInfo& R : Rooms)
+    constexpr uint32 Fields = EMapCellField::Object | EMapCellField::Durability;
+    Map->ForEachCellInRect<Fields>(Box, [&](const FMapCellView& V)
+    {
+        if (Labels[Idx(V.X,V.Y,W)] != ZoneId) return;
+
+        // Truly empty, or an object that may be carved; immutable tags must never be removed
+        if (!V.HasObject()) Z.Cells[Local(V.X,V.Y)] = FZoneLinks::Open;
+        else if (!ImmutableMask.Contains(V.ObjectId)) Z.Cells[Local(V.X,V.Y)] = FZoneLinks::MutableWall;
+    });
+
+    // Rooms: interior, walls and entrance are non-traversable and immutable (do not go through the door)
+    for (const FRoomInfo& R : Map->GetRooms())
     {
         if (R.ZoneId != ZoneId) continue;
         for (int32 dy = 0; dy < R.Size.Y; ++dy)
         for (int32 dx = 0; dx < R.Size.X; ++dx)
         {
-            RoomInterior.Add(FIntPoint(R.TopLeft.X + dx, R.TopLeft.Y + dy));
-        }
-        const int x0=R.TopLeft.X, y0=R.TopLeft.Y, w=R.Size.X, h=R.Size.Y;
-        // Edges
-        for (int dx=0; dx<w; ++dx)
-        {
-            RoomWalls.Add(FIntPoint(x0+dx, y0));
-            RoomWalls.Add(FIntPoint(x0+dx, y0+h-1));
-        }
-        for (int dy=1; dy<h-1; ++dy)
-        {
-            RoomWalls.Add(FIntPoint(x0, y0+dy));
-            RoomWalls.Add(FIntPoint(x0+w-1, y0+dy));
-        }
-        // Entrance: mark as non-traversable in connectivity (do not go through door)
-        RoomWalls.Add(R.Entrance);
-        RoomInterior.Add(R.Entrance);
-
-        // Force-free the cell directly outside the entrance within the same zone.
-        // This guarantees the room has an exit into traversable space.
-        FIntPoint Outside = R.Entrance;
-        if (R.Entrance.Y == y0)            { Outside.Y -= 1; }           // entrance on top edge -> outside north
-        else if (R.Entrance.Y == y0 + h - 1) { Outside.Y += 1; }         // bottom edge -> outside south
-        else if (R.Entrance.X == x0)       { Outside.X -= 1; }           // left edge -> outside west
-        else if (R.Entrance.X == x0 + w - 1) { Outside.X += 1; }         // right edge -> outside east
-
-        if (Map->IsInBounds(Outside.X, Outside.Y))
-        {
-            const int oid = Idx(Outside.X, Outside.Y, W);
-            if (Labels.IsValidIndex(oid) && Labels[oid] == ZoneId)
-            {
-                FGameplayTag ObjTag; int32 ObjDur = 0;
-                if (Map->GetObjectAt(Outside.X, Outside.Y, ObjTag, ObjDur))
-                {
-                    Map->RemoveObjectAt(Outside.X, Outside.Y);
-                }
-            }
+            const int32 x = R.TopLeft.X + dx, y = R.TopLeft.Y + dy;
+            if (Box.Contains(FIntPoint(x, y))) Z.Cells[Local(x, y)] = FZoneLinks::Blocked;
         }
     }
 
-    // Passages: OPEN (targets to reach); do not modify openness here
-    for (const FZonePassage& P : Passages)
-    {
-        for (const FIntPoint& C : P.Cells) { /* keep open */ }
-    }
-
-    for (int32 y=0; y<H; ++y)
-    for (int32 x=0; x<W; ++x)
-    {
-        const int id = Idx(x,y,W);
-        if (Labels[id] != ZoneId) { ImmWall[id]=1; continue; } // treat outside as wall
-
-        // Room interior/door: non-traversable, immutable
-        if (RoomInterior.Contains(FIntPoint(x,y))) { ImmWall[id]=1; continue; }
-
-        // Object check
-        FGameplayTag Obj; int32 Dur=0; const bool bHasObj = Map->GetObjectAt(x,y,Obj,Dur);
-        if (!bHasObj || Dur <= 0)
-        {
-            Open[id] = 1; // truly empty
-            continue;
-        }
-
-        // Immutable tags must never be removed
-        if (ImmutableObjectTags.Contains(Obj) || RoomWalls.Contains(FIntPoint(x,y)))
-        {
-            ImmWall[id] = 1;
-        }
-        else
-        {
-            // Any other object inside the zone is a candidate for carving
-            MutWall[id] = 1;
-        }
-    }
+    // Passages stay as they are: open cells are targets to reach
 }
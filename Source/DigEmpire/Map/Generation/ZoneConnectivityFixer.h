@@ -6,12 +6,14 @@
 #include "ZoneConnectivityFixer.generated.h"
 
 class UMapGrid2D;
+class FMapGenerationContext;
+struct FMapTagMask;
 
 /**
- * For each zone: picks the largest connected open component and
- * carves minimal corridors (within the same zone) to connect all
- * other open components to it. Does not remove walls between zones
- * and does not remove room walls.
+ * For each zone: links all connected open components with minimal
+ * corridors (within the same zone), like a minimum spanning tree over
+ * component distances. Does not remove walls between zones and does
+ * not remove room walls.
  */
 UCLASS(BlueprintType)
 class UZoneConnectivityFixer : public UObject
@@ -32,15 +34,42 @@ class UZoneConnectivityFixer : public UObject
                   float DebugSphereRadiusUU,
                   float DebugLifetime);
 
+    /** Same against a step context, whose zone bounds are shared with the other steps. */
+    bool Generate(FMapGenerationContext& Context,
+                  const TArray<FGameplayTag>& ImmutableObjectTags,
+                  bool bDebugDraw,
+                  float DebugTileSizeUU,
+                  float DebugZOffset,
+                  float DebugSphereRadiusUU,
+                  float DebugLifetime);
+
 private:
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
-    struct FNode { int16 X, Y; };
 
-    void BuildMasksForZone(UMapGrid2D* Map,
+    /**
+     * Connectivity state of one zone over its bounding box.
+     * Index = (X - Box.Min.X) + (Y - Box.Min.Y) * Box.Width().
+     */
+    struct FZoneLinks
+    {
+        enum : uint8 { Blocked = 0, Open = 1, MutableWall = 2 };
+
+        FIntRect Box;                 // zone bounds in map cells (Max exclusive)
+        TArray<uint8> Cells;          // Blocked / Open / MutableWall (other zones, rooms, immutable walls are Blocked)
+        TArray<int32> Comp;           // open component id, -1 otherwise
+        int32 NumComps = 0;
+        TArray<uint8> CompLinked;     // 1 if joined to the largest component
+        TArray<FIntPoint> Carve;      // mutable walls to remove, in map cells
+    };
+
+    void BuildMasksForZone(const UMapGrid2D* Map,
                            const TArray<int32>& Labels,
                            int32 ZoneId,
-                           const TArray<FGameplayTag>& ImmutableObjectTags,
-                           /*out*/ TArray<uint8>& Open,      // 1=open, 0=not
-                           /*out*/ TArray<uint8>& ImmWall,   // 1=immutable wall
-                           /*out*/ TArray<uint8>& MutWall);  // 1=mutable wall
+                           const FMapTagMask& ImmutableMask,
+                           /*in/out*/ FZoneLinks& Zone) const;
+
+    void LabelComponents(FZoneLinks& Zone) const;
+
+    /** One multi-source 0-1 BFS from all components, then Kruskal over the component boundary links. */
+    void LinkComponents(FZoneLinks& Zone) const;
 };
@@ -2,12 +2,14 @@
 
 #include "ZoneConnectivityFixer.h"
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 
-void UZoneConnectivityStepData::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void UZoneConnectivityStepData::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() <= 0) return;
+    if (!Context.HasZoneLabels()) return;
     UZoneConnectivityFixer* Fixer = NewObject<UZoneConnectivityFixer>();
-    Fixer->Generate(Map, InOutZoneLabels, ImmutableObjectTags,
+    Fixer->Generate(Context, ImmutableObjectTags,
                     bDebugDrawUnconnected, DebugTileSizeUU, DebugZOffset, DebugSphereRadiusUU, DebugLifetime);
 }
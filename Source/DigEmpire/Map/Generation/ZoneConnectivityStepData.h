@@ -32,5 +32,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Debug")
     float DebugLifetime = 5.f;
 
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Zones | EMapGenAccess::Objects | EMapGenAccess::Passages | EMapGenAccess::Rooms; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::Objects; }
 };
@@ -1,16 +1,18 @@
 #include "ZoneDepthStepData.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "DigEmpire/Map/MapGrid2DComponent.h"
 #include "ZonePassageTypes.h"
 
-void UZoneDepthStepData::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void UZoneDepthStepData::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() == 0) return;
+    if (!Context.HasZoneLabels()) return;
 
     // Determine number of zones
-    int32 MaxZoneId = 0; for (int v : InOutZoneLabels) if (v > MaxZoneId) MaxZoneId = v;
+    int32 MaxZoneId = 0; for (int v : Context.GetZoneLabels()) if (v > MaxZoneId) MaxZoneId = v;
     const int32 NumZones = MaxZoneId + 1;
     if (NumZones <= 0) return;
 
@@ -48,12 +50,10 @@ void UZoneDepthStepData::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*
         }
     }
 
-    if (UObject* OuterObj = Map->GetOuter())
+    Map->SetZoneDepths(Depths);
+    if (UMapGrid2DComponent* Comp = Cast<UMapGrid2DComponent>(Map->GetOuter()))
     {
-        if (UMapGrid2DComponent* Comp = Cast<UMapGrid2DComponent>(OuterObj))
-        {
-            Comp->SetZoneDepths(Depths);
-        }
+        Comp->SetZoneDepths(Depths); // keep the component's editor-visible mirror in sync
     }
 }
 
@@ -10,6 +10,9 @@ class UZoneDepthStepData : public UMapGenerationStepDataBase
 {
     GENERATED_BODY()
 public:
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Passages; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::ZoneDepths; }
 };
 
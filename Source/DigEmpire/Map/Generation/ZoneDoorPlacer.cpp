@@ -1,7 +1,6 @@
 #include "ZoneDoorPlacer.h"
 #include "ZoneDoorSettings.h"
 #include "DigEmpire/Map/MapGrid2D.h"
-#include "DigEmpire/Map/MapGrid2DComponent.h"
 #include "DigEmpire/Map/DoorCellActor.h"
 #include "DigEmpire/Map/KeyCellActor.h"
 #include "Engine/World.h"
@@ -11,6 +10,9 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
     if (!MapGrid || !Settings || !World) return false;
     if (!Settings->DoorClass) return false;
 
+    FRandomStream RNG(Settings->RandomSeed);
+    if (Settings->RandomSeed < 0) RNG.GenerateNewSeed();
+
     const TArray<FZonePassage>& Passages = MapGrid->GetPassages();
     if (Passages.Num() == 0) return true; // nothing to do
 
@@ -49,8 +51,7 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
     }
 
     // 2) Assign door colors and spawn keys per zone using depth order rules
-    UMapGrid2DComponent* Comp = Cast<UMapGrid2DComponent>(MapGrid->GetOuter());
-    if (!Comp)
+    if (MapGrid->GetZoneDepths().Num() == 0)
     {
         return true; // doors placed; can't compute depth-based keys
     }
@@ -61,8 +62,8 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
     TArray<int32> Zones = ZonesSet.Array();
     Zones.Sort([&](int32 A, int32 B)
     {
-        const int32 dA = Comp->GetZoneDepth(A);
-        const int32 dB = Comp->GetZoneDepth(B);
+        const int32 dA = MapGrid->GetZoneDepth(A);
+        const int32 dB = MapGrid->GetZoneDepth(B);
         if (dA != dB) return dA < dB;
         return A < B;
     });
@@ -70,7 +71,7 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
     TSet<int32> ColoredDoorIdx; // indices in Placed already colored
     for (int32 ZoneId : Zones)
     {
-        const int32 ZoneDepth = Comp->GetZoneDepth(ZoneId);
+        const int32 ZoneDepth = MapGrid->GetZoneDepth(ZoneId);
         if (ZoneDepth < 0) continue;
 
         // Fetch color tag for this zone
@@ -92,7 +93,7 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
             if (!bAdjacent) continue;
 
             const int32 Other = (D.ZoneA == ZoneId) ? D.ZoneB : D.ZoneA;
-            const int32 OtherDepth = Comp->GetZoneDepth(Other);
+            const int32 OtherDepth = MapGrid->GetZoneDepth(Other);
             if (ZoneDepth == 0)
             {
                 // Zone 0 claims all its adjacent doors
@@ -116,7 +117,7 @@ bool UZoneDoorPlacer::Generate(UMapGrid2D* MapGrid, const UZoneDoorSettings* Set
         if (bClaimedAny && Settings->KeyClass)
         {
             FIntPoint KeyCell;
-            if (FindFreeCellInZone(MapGrid, ZoneId, KeyCell))
+            if (FindFreeCellInZone(MapGrid, ZoneId, RNG, KeyCell))
             {
                 const FVector KLoc(KeyCell.X * Settings->TileSizeUU,
                                    KeyCell.Y * Settings->TileSizeUU,
@@ -160,24 +161,9 @@ FIntPoint UZoneDoorPlacer::PickMidCell(const TArray<FIntPoint>& Cells)
     return Cells[bestIdx];
 }
 
-bool UZoneDoorPlacer::FindFreeCellInZone(UMapGrid2D* Map, int32 ZoneId, /*out*/ FIntPoint& OutCell) const
+bool UZoneDoorPlacer::FindFreeCellInZone(UMapGrid2D* Map, int32 ZoneId, const FRandomStream& RNG, /*out*/ FIntPoint& OutCell) const
 {
     if (!Map || ZoneId < 0) return false;
-    const FIntPoint Size = Map->GetSize();
-    TArray<FIntPoint> Candidates;
-    for (int32 y = 0; y < Size.Y; ++y)
-    {
-        for (int32 x = 0; x < Size.X; ++x)
-        {
-            if (Map->GetZoneAt(x, y) != ZoneId) continue;
-            if (Map->GetActorAt(x, y)) continue;
-            FGameplayTag T; int32 D;
-            if (Map->GetObjectAt(x, y, T, D)) continue; // occupied by wall/object
-            Candidates.Add(FIntPoint(x, y));
-        }
-    }
-    if (Candidates.Num() == 0) return false;
-    const int32 idx = FMath::RandRange(0, Candidates.Num() - 1);
-    OutCell = Candidates[idx];
-    return true;
+    // Grid keeps per-zone lists of cells with no wall/object and no actor
+    return Map->SampleFreeCellInZone(ZoneId, RNG, OutCell);
 }
@@ -22,5 +22,5 @@ public:
 private:
     static FIntPoint PickMidCell(const TArray<FIntPoint>& Cells);
 
-    bool FindFreeCellInZone(UMapGrid2D* Map, int32 ZoneId, /*out*/ FIntPoint& OutCell) const;
+    bool FindFreeCellInZone(UMapGrid2D* Map, int32 ZoneId, const FRandomStream& RNG, /*out*/ FIntPoint& OutCell) const;
 };
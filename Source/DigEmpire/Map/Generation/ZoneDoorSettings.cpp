@@ -1,10 +1,13 @@
 #include "ZoneDoorSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "MapGenerationContext.h"
 #include "ZoneDoorPlacer.h"
 
-void UZoneDoorSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& /*InOutZoneLabels*/) const
+void UZoneDoorSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
+    UWorld* World = Context.GetWorld();
     if (!Map || !World) return;
     if (!DoorClass) return;
     UZoneDoorPlacer* Placer = NewObject<UZoneDoorPlacer>();
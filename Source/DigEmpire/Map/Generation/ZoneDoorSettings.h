@@ -37,6 +37,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Key")
     TMap<int32, FGameplayTag> ZoneColorTags;
 
+    /** Random seed for key cells; if < 0 a random seed is used. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Random")
+    int32 RandomSeed = -1;
+
     // Execute step: place door actors along passages
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    // Spawns actors
+    virtual bool RequiresGameThread() const override { return true; }
 };
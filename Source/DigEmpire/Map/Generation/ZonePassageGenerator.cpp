@@ -1,23 +1,44 @@
 #include "ZonePassageGenerator.h"
 #include "DrawDebugHelpers.h"
-#include "Algo/RandomShuffle.h"
 #include "DigEmpire/Map/MapGrid2D.h"
 
+namespace
+{
+    /** Fisher-Yates driven by the step's stream, so a fixed seed gives the same passages every run. */
+    template<typename T>
+    void ShuffleWith(FRandomStream& RNG, TArray<T>& Items)
+    {
+        for (int32 i = Items.Num() - 1; i > 0; --i)
+        {
+            const int32 j = RNG.RandRange(0, i);
+            if (i != j) Items.Swap(i, j);
+        }
+    }
+}
+
 bool UZonePassageGenerator::Generate(UMapGrid2D* MapGrid,
                                      const TArray<int32>& ZoneLabels,
                                      const UZoneBorderSettings* Settings)
 {
-    if (!ValidateInputs(MapGrid, ZoneLabels, Settings))
+    FMapGenerationContext Context(MapGrid, /*World*/ nullptr);
+    Context.SetZoneLabels(CopyTemp(ZoneLabels));
+    return Generate(Context, Settings);
+}
+
+bool UZonePassageGenerator::Generate(FMapGenerationContext& Context, const UZoneBorderSettings* Settings)
+{
+    UMapGrid2D* MapGrid = Context.GetMap();
+    if (!ValidateInputs(MapGrid, Context.GetZoneLabels(), Settings))
         return false;
 
-    CachedLabels = ZoneLabels;
+    CachedLabels = Context.ShareZoneLabels();
     CachedSize = MapGrid->GetSize();
-    PassageMask.Reset();
     Passages.Reset();
 
     TMap<FIntPoint, TSet<FIntPoint>> PairToA, PairToB;
-    CollectZoneBoundaries(CachedLabels, PairToA, PairToB);
-    ChooseAndCarvePassages(MapGrid, Settings, PairToA, PairToB);
+    CollectZoneBoundaries(*CachedLabels, PairToA, PairToB);
+    ChooseAndCarvePassages(MapGrid, Settings, PairToA, PairToB, Context.GetScratch());
+    PassageDistance = TArrayView<uint16>();
     return true;
 }
 
@@ -77,14 +98,21 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
     UMapGrid2D* Map,
     const UZoneBorderSettings* Settings,
     const TMap<FIntPoint, TSet<FIntPoint>>& PairToA,
-    const TMap<FIntPoint, TSet<FIntPoint>>& PairToB)
+    const TMap<FIntPoint, TSet<FIntPoint>>& PairToB,
+    FMapGenScratchArena& Scratch)
 {
     const int32 Seed = (Settings->RandomSeed >= 0) ? Settings->RandomSeed : FMath::Rand();
     FRandomStream RNG(Seed);
 
-    PassageMask.Reset();
     Passages.Reset();
 
+    // Spacing: a new passage may not come within MinPassageDistance of the protection mask,
+    // i.e. the passage cells dilated by BorderThickness-1 and MinPassageDistance
+    const bool bCheckSpacing = Settings->MinPassageDistance > 0;
+    const int32 SpacingReach = FMath::Min<int32>(MAX_uint16 - 1,
+        FMath::Max(0, Settings->BorderThickness - 1) + 2 * Settings->MinPassageDistance);
+    PassageDistance = Scratch.Alloc<uint16>(CachedSize.X * CachedSize.Y, MAX_uint16);
+
     // Degree caps
     TMap<int32,int32> DegreeCap, DegreeNow;
     TSet<int32> ZonesInvolved;
@@ -104,7 +132,7 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
     // Randomize pair order
     TArray<FIntPoint> Pairs; Pairs.Reserve(PairToA.Num());
     for (const auto& kv : PairToA) Pairs.Add(kv.Key);
-    Algo::RandomShuffle(Pairs);
+    ShuffleWith(RNG, Pairs);
 
     const int32 W = CachedSize.X, H = CachedSize.Y;
     auto InBounds2 = [&](int x,int y){ return x>=0 && y>=0 && x<W && y<H; };
@@ -120,7 +148,7 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
         TArray<FIntPoint> ACands;
         ACands.Reserve(ASetPtr->Num());
         for (const FIntPoint& c : *ASetPtr) ACands.Add(c);
-        Algo::RandomShuffle(ACands);
+        ShuffleWith(RNG, ACands);
 
         bool bCarved = false;
         int32 attemptsLeft = FMath::Max(1, Settings->AttemptsPerPair);
@@ -163,7 +191,7 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
             TArray<FIntPoint> Preview;
             Preview.Reserve(ToClearA.Num() + ToClearB.Num());
             Preview.Append(ToClearA); Preview.Append(ToClearB);
-            if (IsTooCloseToExistingPassages(Preview, Settings->MinPassageDistance))
+            if (bCheckSpacing && IsTooCloseToExistingPassages(Preview, SpacingReach))
             {
                 continue; // too close to existing passages
             }
@@ -179,10 +207,8 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
             Passages.Add(MoveTemp(Pass));
             DegreeNow[Key.X]++; DegreeNow[Key.Y]++;
 
-            // Update protection mask: passage cells + dilation to shield/space subsequent passages
-            for (const FIntPoint& c : Passages.Last().Cells) PassageMask.Add(c);
-            DilateMask(PassageMask, FMath::Max(0, Settings->BorderThickness - 1));
-            DilateMask(PassageMask, Settings->MinPassageDistance);
+            // Update protection mask around the new passage only
+            if (bCheckSpacing) AddToPassageDistance(Passages.Last().Cells, SpacingReach);
 
             // Debug visualization by zone side
             if (Settings->bDebugDrawPassages)
@@ -192,9 +218,9 @@ void UZonePassageGenerator::ChooseAndCarvePassages(
                 for (const FIntPoint& c : Passages.Last().Cells)
                 {
                     const int32 id = Idx(c.X, c.Y, CachedSize.X);
-                    if (id >= 0 && id < CachedLabels.Num())
+                    if (id >= 0 && id < CachedLabels->Num())
                     {
-                        const int32 z = CachedLabels[id];
+                        const int32 z = (*CachedLabels)[id];
                         if (z == Key.X) CellsA.Add(c);
                         else if (z == Key.Y) CellsB.Add(c);
                     }
@@ -222,10 +248,10 @@ void UZonePassageGenerator::DebugDrawPassageCells(const UZoneBorderSettings* Set
         FColor UseColor = Color;
         const int32 W = CachedSize.X;
         const int32 H = CachedSize.Y;
-        if (W > 0 && H > 0 && CachedLabels.Num() == W * H && c.X >= 0 && c.Y >= 0 && c.X < W && c.Y < H)
+        if (W > 0 && H > 0 && CachedLabels && CachedLabels->Num() == W * H && c.X >= 0 && c.Y >= 0 && c.X < W && c.Y < H)
         {
             const int32 id = Idx(c.X, c.Y, W);
-            const int32 ZoneId = CachedLabels.IsValidIndex(id) ? CachedLabels[id] : -1;
+            const int32 ZoneId = CachedLabels->IsValidIndex(id) ? (*CachedLabels)[id] : -1;
             if (ZoneId >= 0)
             {
                 const uint8 H8 = uint8((ZoneId * 47) & 0xFF);
@@ -237,25 +263,6 @@ void UZonePassageGenerator::DebugDrawPassageCells(const UZoneBorderSettings* Set
     }
 }
 
-void UZonePassageGenerator::DilateMask(TSet<FIntPoint>& InOutMask, int32 Radius) const
-{
-    if (Radius <= 0) return;
-    TSet<FIntPoint> Add;
-    for (const FIntPoint& p : InOutMask)
-    {
-        for (int32 dy = -Radius; dy <= Radius; ++dy)
-        {
-            const int32 rem = Radius - FMath::Abs(dy);
-            for (int32 dx = -rem; dx <= rem; ++dx)
-            {
-                const FIntPoint q(p.X + dx, p.Y + dy);
-                if (InBounds(q.X, q.Y)) Add.Add(q);
-            }
-        }
-    }
-    InOutMask.Append(Add);
-}
-
 bool UZonePassageGenerator::BuildCarveStripePreview(
     UMapGrid2D* Map,
     const FIntPoint& AnchorA,
@@ -270,12 +277,11 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
     OutCellsB.Reset();
 
     const int32 W = CachedSize.X, H = CachedSize.Y;
+    const TArray<int32>& Labels = *CachedLabels;
     auto InBounds2 = [&](int x, int y){ return x>=0 && y>=0 && x<W && y<H; };
     auto IsEmpty = [&](int x, int y)->bool
     {
-        FGameplayTag Obj; int32 Dur=0;
-        if (!Map->GetObjectAt(x,y,Obj,Dur)) return true;
-        return !(Obj.IsValid() && Dur > 0);
+        return !Map->HasObjectAt(x,y);
     };
 
     const int32 Half = FMath::Max(0, PassageWidth / 2);
@@ -298,7 +304,7 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
             int steps=0; const int maxSteps = FMath::Max(CachedSize.X, CachedSize.Y);
             while (InBounds2(x, y) && steps++ < maxSteps)
             {
-                if (CachedLabels[Idx(x,y,W)] != ZoneA) return false;
+                if (Labels[Idx(x,y,W)] != ZoneA) return false;
                 if (IsEmpty(x,y)) { TerminalEmptyA.Add(FIntPoint(x,y)); break; }
                 ColA.Add(FIntPoint(x,y));
                 x += InwardA.X; y += InwardA.Y; 
@@ -313,7 +319,7 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
             bool bFoundEmptyB = false; FIntPoint TermB(0,0);
             while (InBounds2(x, y) && steps++ < maxSteps)
             {
-                if (CachedLabels[Idx(x,y,W)] != ZoneB) return false;
+                if (Labels[Idx(x,y,W)] != ZoneB) return false;
                 if (IsEmpty(x,y)) { TerminalEmptyB.Add(FIntPoint(x,y)); TermB = FIntPoint(x,y); bFoundEmptyB = true; break; }
                 ColB.Add(FIntPoint(x,y));
                 x += OutwardB.X; y += OutwardB.Y; 
@@ -332,15 +338,15 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
     {
         const FIntPoint n1(e.X + Tangent.X, e.Y + Tangent.Y);
         const FIntPoint n2(e.X - Tangent.X, e.Y - Tangent.Y);
-        if (InBounds2(n1.X,n1.Y) && CachedLabels[Idx(n1.X,n1.Y,W)] == ZoneB) return false;
-        if (InBounds2(n2.X,n2.Y) && CachedLabels[Idx(n2.X,n2.Y,W)] == ZoneB) return false;
+        if (InBounds2(n1.X,n1.Y) && Labels[Idx(n1.X,n1.Y,W)] == ZoneB) return false;
+        if (InBounds2(n2.X,n2.Y) && Labels[Idx(n2.X,n2.Y,W)] == ZoneB) return false;
     }
     for (const FIntPoint& e : TerminalEmptyB)
     {
         const FIntPoint n1(e.X + Tangent.X, e.Y + Tangent.Y);
         const FIntPoint n2(e.X - Tangent.X, e.Y - Tangent.Y);
-        if (InBounds2(n1.X,n1.Y) && CachedLabels[Idx(n1.X,n1.Y,W)] == ZoneA) return false;
-        if (InBounds2(n2.X,n2.Y) && CachedLabels[Idx(n2.X,n2.Y,W)] == ZoneA) return false;
+        if (InBounds2(n1.X,n1.Y) && Labels[Idx(n1.X,n1.Y,W)] == ZoneA) return false;
+        if (InBounds2(n2.X,n2.Y) && Labels[Idx(n2.X,n2.Y,W)] == ZoneA) return false;
 
         // Additional requirement: terminal empty B cell must have at least
         // one adjacent empty cell within ZoneB to ensure it opens into space.
@@ -349,7 +355,7 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
         for (const FIntPoint& n : N4)
         {
             if (!InBounds2(n.X, n.Y)) continue;
-            if (CachedLabels[Idx(n.X,n.Y,W)] != ZoneB) continue;
+            if (Labels[Idx(n.X,n.Y,W)] != ZoneB) continue;
             if (IsEmpty(n.X, n.Y)) { bHasEmptyNeighborInB = true; break; }
         }
         if (!bHasEmptyNeighborInB) return false;
@@ -358,21 +364,41 @@ bool UZonePassageGenerator::BuildCarveStripePreview(
     return true;
 }
 
-bool UZonePassageGenerator::IsTooCloseToExistingPassages(const TArray<FIntPoint>& CandidateCells, int32 MinDist) const
+bool UZonePassageGenerator::IsTooCloseToExistingPassages(const TArray<FIntPoint>& CandidateCells, int32 Reach) const
 {
-    if (MinDist <= 0 || PassageMask.Num() == 0) return false;
+    if (Reach < 0 || Passages.Num() == 0) return false;
     for (const FIntPoint& c : CandidateCells)
     {
-        for (int32 dy = -MinDist; dy <= MinDist; ++dy)
+        if (InBounds(c.X, c.Y) && PassageDistance[Idx(c.X, c.Y, CachedSize.X)] <= Reach) return true;
+    }
+    return false;
+}
+
+void UZonePassageGenerator::AddToPassageDistance(const TArray<FIntPoint>& Cells, int32 Reach)
+{
+    // Multi-source BFS by layers from the new cells; it only spreads through cells that get
+    // closer, so each passage costs at most the area within Reach of it
+    TArray<FIntPoint> Layer, Next;
+    for (const FIntPoint& c : Cells)
+    {
+        if (!InBounds(c.X, c.Y) || PassageDistance[Idx(c.X, c.Y, CachedSize.X)] == 0) continue;
+        PassageDistance[Idx(c.X, c.Y, CachedSize.X)] = 0;
+        Layer.Add(c);
+    }
+
+    for (int32 d = 1; d <= Reach && Layer.Num() > 0; ++d)
+    {
+        Next.Reset();
+        for (const FIntPoint& p : Layer)
         {
-            const int32 rem = MinDist - FMath::Abs(dy);
-            for (int32 dx = -rem; dx <= rem; ++dx)
+            const FIntPoint N4[4] = { {p.X+1,p.Y},{p.X-1,p.Y},{p.X,p.Y+1},{p.X,p.Y-1} };
+            for (const FIntPoint& n : N4)
             {
-                const FIntPoint q(c.X + dx, c.Y + dy);
-                if (!InBounds(q.X, q.Y)) continue;
-                if (PassageMask.Contains(q)) return true;
+                if (!InBounds(n.X, n.Y) || PassageDistance[Idx(n.X, n.Y, CachedSize.X)] <= d) continue;
+                PassageDistance[Idx(n.X, n.Y, CachedSize.X)] = uint16(d);
+                Next.Add(n);
             }
         }
+        Swap(Layer, Next);
     }
-    return false;
 }
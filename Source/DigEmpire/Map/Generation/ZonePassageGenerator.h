@@ -4,6 +4,7 @@
 #include "UObject/Object.h"
 #include "ZoneBorderSettings.h"
 #include "ZonePassageTypes.h"
+#include "MapGenerationContext.h"
 #include "ZonePassageGenerator.generated.h"
 
 class UMapGrid2D;
@@ -19,14 +20,20 @@ public:
                   const TArray<int32>& ZoneLabels,
                   const UZoneBorderSettings* Settings);
 
+    /** Generate against a step context: the labels are shared instead of copied, scratch comes from its arena. */
+    bool Generate(FMapGenerationContext& Context, const UZoneBorderSettings* Settings);
+
     UFUNCTION(BlueprintPure, Category="ZonePassages|Query")
     const TArray<FZonePassage>& GetPassages() const { return Passages; }
 
 private:
-    UPROPERTY(Transient) TArray<int32> CachedLabels;
+    TSharedPtr<const TArray<int32>, ESPMode::ThreadSafe> CachedLabels;
     UPROPERTY(Transient) FIntPoint CachedSize = FIntPoint::ZeroValue;
     UPROPERTY(Transient) TArray<FZonePassage> Passages;
-    UPROPERTY(Transient) TSet<FIntPoint> PassageMask; // global protection mask
+
+    // Global protection mask as a distance field: Manhattan distance to the nearest carved
+    // passage cell, exact up to the spacing reach and MAX_uint16 beyond it (arena scratch, valid during Generate)
+    TArrayView<uint16> PassageDistance;
 
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
     inline bool InBounds(int32 X, int32 Y) const { return X>=0 && Y>=0 && X<CachedSize.X && Y<CachedSize.Y; }
@@ -39,12 +46,13 @@ private:
     void ChooseAndCarvePassages(UMapGrid2D* Map,
                                 const UZoneBorderSettings* Settings,
                                 const TMap<FIntPoint, TSet<FIntPoint>>& PairToA,
-                                const TMap<FIntPoint, TSet<FIntPoint>>& PairToB);
+                                const TMap<FIntPoint, TSet<FIntPoint>>& PairToB,
+                                FMapGenScratchArena& Scratch);
 
     // Helpers for carving
     void ClearCell(UMapGrid2D* Map, int32 X, int32 Y) const;
-    bool IsTooCloseToExistingPassages(const TArray<FIntPoint>& CandidateCells, int32 MinDist) const;
-    void DilateMask(TSet<FIntPoint>& InOutMask, int32 Radius) const;
+    bool IsTooCloseToExistingPassages(const TArray<FIntPoint>& CandidateCells, int32 Reach) const;
+    void AddToPassageDistance(const TArray<FIntPoint>& Cells, int32 Reach);
     bool BuildCarveStripePreview(UMapGrid2D* Map,
                                  const FIntPoint& AnchorA,
                                  bool bVerticalBoundary,
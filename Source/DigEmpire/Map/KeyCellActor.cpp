@@ -31,3 +31,16 @@ void AKeyCellActor::SetDoorColor(const FGameplayTag& InColor)
     DoorColor = InColor;
     OnDoorColorAssigned(InColor);
 }
+
+void AKeyCellActor::SerializeCellState(FArchive& Ar)
+{
+    Super::SerializeCellState(Ar);
+
+    FName ColorName = DoorColor.GetTagName();
+    Ar << ColorName;
+
+    if (Ar.IsLoading() && !Ar.IsError())
+    {
+        SetDoorColor(FGameplayTag::RequestGameplayTag(ColorName, /*ErrorIfNotFound*/ false));
+    }
+}
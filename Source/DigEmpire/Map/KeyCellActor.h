@@ -26,6 +26,8 @@ public:
     UFUNCTION(BlueprintCallable, Category="Key")
     void SetDoorColor(const FGameplayTag& InColor);
 
+    virtual void SerializeCellState(FArchive& Ar) override;
+
     /** Fired when DoorColor is assigned (via SetDoorColor). */
     UFUNCTION(BlueprintNativeEvent, Category="Key|Events")
     void OnDoorColorAssigned(const FGameplayTag& InColor);
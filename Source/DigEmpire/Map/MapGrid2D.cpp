@@ -1,31 +1,184 @@
 #include "MapGrid2D.h"
 #include "CellActor.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
-void UMapGrid2D::Initialize(int32 InSizeX, int32 InSizeY)
+namespace MapGridSave
+{
+    static constexpr uint32 Magic = 0x474D4544; // "DEMG"
+    static constexpr int32 Version = 1;
+
+    /** Sanity cap so a corrupt header cannot request a huge allocation */
+    static constexpr int32 MaxUncompressedSize = 512 * 1024 * 1024;
+
+    static void SerializeRooms(FArchive& Ar, TArray<FRoomInfo>& Rooms)
+    {
+        int32 Num = Rooms.Num();
+        Ar << Num;
+        if (Ar.IsLoading())
+        {
+            if (Num < 0 || Num > Ar.TotalSize() - Ar.Tell()) { Ar.SetError(); return; }
+            Rooms.SetNum(Num);
+        }
+        for (FRoomInfo& R : Rooms)
+        {
+            Ar << R.ZoneId << R.TopLeft << R.Size << R.Entrance;
+        }
+    }
+
+    static void SerializePassages(FArchive& Ar, TArray<FZonePassage>& Passages)
+    {
+        int32 Num = Passages.Num();
+        Ar << Num;
+        if (Ar.IsLoading())
+        {
+            if (Num < 0 || Num > Ar.TotalSize() - Ar.Tell()) { Ar.SetError(); return; }
+            Passages.SetNum(Num);
+        }
+        for (FZonePassage& P : Passages)
+        {
+            Ar << P.ZoneA << P.ZoneB << P.Cells;
+        }
+    }
+}
+
+void UMapGrid2D::Initialize(int32 InSizeX, int32 InSizeY, bool bChunkedStorage)
 {
     SizeX = FMath::Max(0, InSizeX);
     SizeY = FMath::Max(0, InSizeY);
 
-    const int32 Count = SizeX * SizeY;
-    Cells.SetNum(Count);
+    // Reset content: every plane is rebuilt at the new size with its empty value
+    Palette.Reset();
+    Palette.Add(FGameplayTag());
+    PaletteLookup.Reset();
+
+    BackgroundIds.Init(SizeX, SizeY, 0, bChunkedStorage);
+    ObjectIds.Init(SizeX, SizeY, 0, bChunkedStorage);
+    ObjectDurability.Init(SizeX, SizeY, 0, bChunkedStorage);
+    OreIds.Init(SizeX, SizeY, 0, bChunkedStorage);
+    ZoneIds.Init(SizeX, SizeY, -1, bChunkedStorage);
+    Viewed.Init(SizeX, SizeY);
+    Blocked.Init(SizeX, SizeY);
+    DirtyBits.Init(SizeX, SizeY);
+    DirtyCells.Reset();
+    Occupants.Reset();
+
+    FreeBits.Init(SizeX, SizeY);
+    FreeListed.Init(SizeX, SizeY);
+    ZoneCellStart.Reset();
+    ZoneCellIndices.Reset();
+    ZoneBounds.Reset();
+    ZoneFreeCells.Reset();
+    ZoneNumFree.Reset();
+    bZoneIndexValid = false;
+    ZoneDepths.Reset();
+    BumpEpoch();
+}
+
+void UMapGrid2D::FillBackground(const FGameplayTag& BackgroundTag)
+{
+    const uint16 Id = InternTag(BackgroundTag);
+    uint64 NumChanged = 0;
+    // Journal only the cells whose background actually changes
+    ForEachCellInRect<EMapCellField::Background>(FIntRect(0, 0, SizeX, SizeY), [&](const FMapCellView& V)
+    {
+        if (V.BackgroundId == Id) return;
+        ++NumChanged;
+        MarkDirty(V.X, V.Y);
+    });
+    if (NumChanged == 0) return;
+
+    BackgroundIds.Fill(Id);
+    CountCellChanges(NumChanged);
+    BumpEpoch();
+}
+
+void UMapGrid2D::SetChangeJournalEnabled(bool bEnabled)
+{
+    if (!bEnabled)
+    {
+        DiscardChanges();
+    }
+    bJournalEnabled = bEnabled;
+}
+
+void UMapGrid2D::ConsumeChangedCells(TArray<int32>& OutIndices)
+{
+    for (const int32 id : DirtyCells)
+    {
+        DirtyBits.Set(id % SizeX, id / SizeX, false);
+    }
+    OutIndices = MoveTemp(DirtyCells);
+    DirtyCells.Reset();
+}
+
+void UMapGrid2D::DiscardChanges()
+{
+    for (const int32 id : DirtyCells)
+    {
+        DirtyBits.Set(id % SizeX, id / SizeX, false);
+    }
+    DirtyCells.Reset();
+}
+
+int32 UMapGrid2D::CompactStorage()
+{
+    return BackgroundIds.Compact() + ObjectIds.Compact() + ObjectDurability.Compact()
+         + OreIds.Compact() + ZoneIds.Compact();
+}
+
+SIZE_T UMapGrid2D::GetPlaneAllocatedSize() const
+{
+    return BackgroundIds.GetAllocatedSize() + ObjectIds.GetAllocatedSize() + ObjectDurability.GetAllocatedSize()
+         + OreIds.GetAllocatedSize() + ZoneIds.GetAllocatedSize() + Viewed.GetAllocatedSize() + Blocked.GetAllocatedSize()
+         + Occupants.GetAllocatedSize() + FreeBits.GetAllocatedSize() + FreeListed.GetAllocatedSize()
+         + ZoneFreeCells.GetAllocatedSize() + ZoneNumFree.GetAllocatedSize()
+         + ZoneCellStart.GetAllocatedSize() + ZoneCellIndices.GetAllocatedSize();
+}
+
+uint16 UMapGrid2D::InternTag(const FGameplayTag& Tag)
+{
+    if (!Tag.IsValid()) return 0;
+    if (const uint16* Found = PaletteLookup.Find(Tag))
+    {
+        return *Found;
+    }
+    if (!ensureMsgf(Palette.Num() <= MAX_uint16, TEXT("MapGrid2D tag palette is full; %s stored as empty"), *Tag.ToString()))
+    {
+        return 0;
+    }
+    const uint16 NewId = static_cast<uint16>(Palette.Add(Tag));
+    PaletteLookup.Add(Tag, NewId);
+    return NewId;
+}
+
+uint16 UMapGrid2D::FindTagId(const FGameplayTag& Tag) const
+{
+    const uint16* Found = Tag.IsValid() ? PaletteLookup.Find(Tag) : nullptr;
+    return Found ? *Found : 0;
+}
 
-    // Reset content
-    for (FMapCell& Cell : Cells)
+FMapTagMask UMapGrid2D::MakeTagMask(const TArray<FGameplayTag>& Tags) const
+{
+    FMapTagMask Mask;
+    for (const FGameplayTag& Tag : Tags)
     {
-        Cell.BackgroundTag = FGameplayTag(); // empty
-        Cell.ObjectTag = FGameplayTag();     // empty
-        Cell.ObjectDurability = 0;
-        Cell.bVieved = false;
-        Cell.OreTag = FGameplayTag();        // empty
-        Cell.Occupant = nullptr;
-        // ZoneId defaults from struct initializer
+        if (const uint16 Id = FindTagId(Tag))
+        {
+            Mask.Add(Id);
+        }
     }
+    return Mask;
 }
 
 bool UMapGrid2D::SetBackgroundAt(int32 X, int32 Y, const FGameplayTag& BackgroundTag)
 {
     if (!IsInBounds(X, Y)) return false;
-    Cells[Index(X, Y)].BackgroundTag = BackgroundTag;
+    const uint16 Id = InternTag(BackgroundTag);
+    if (BackgroundIds.Get(X, Y) != Id) CountCellChanges(1);
+    BackgroundIds.Set(X, Y, Id);
+    MarkDirty(X, Y);
     return true;
 }
 
@@ -33,34 +186,116 @@ bool UMapGrid2D::AddOrUpdateObjectAt(int32 X, int32 Y, const FGameplayTag& Objec
 {
     if (!IsInBounds(X, Y)) return false;
 
-    FMapCell& Cell = Cells[Index(X, Y)];
+    // Invalid args are treated as deletion by WriteObject
+    WriteObject(X, Y, ObjectTag.IsValid() ? InternTag(ObjectTag) : 0, Durability);
+    return true;
+}
 
-    if (!ObjectTag.IsValid() || Durability <= 0)
+void UMapGrid2D::WriteObject(int32 X, int32 Y, uint16 ObjectId, int32 Durability)
+{
+    if (ObjectId == 0 || Durability <= 0)
     {
-        // Treat invalid args as deletion
-        Cell.ObjectTag = FGameplayTag();
-        Cell.ObjectDurability = 0;
-        return true;
+        ObjectId = 0;
+        Durability = 0;
     }
+    if (ObjectIds.Get(X, Y) != ObjectId || ObjectDurability.Get(X, Y) != Durability) CountCellChanges(1);
+    ObjectIds.Set(X, Y, ObjectId);
+    ObjectDurability.Set(X, Y, Durability);
+    RefreshFreeCell(X, Y);
+    RefreshBlockedAt(X, Y);
+    MarkDirty(X, Y);
+}
 
-    Cell.ObjectTag = ObjectTag;
-    Cell.ObjectDurability = Durability;
-    return true;
+void UMapGrid2D::RefreshBlockedAt(int32 X, int32 Y)
+{
+    if (!IsInBounds(X, Y)) return;
+    // Same rule as movement always used: an occupant decides, otherwise any object blocks
+    const ACellActor* Occupant = GetActorAt(X, Y);
+    const bool bBlocked = Occupant ? Occupant->IsBlocked() : ObjectDurability.Get(X, Y) > 0;
+    if (Blocked.Get(X, Y) != bBlocked)
+    {
+        Blocked.Set(X, Y, bBlocked);
+        BumpEpoch();
+    }
+}
+
+void UMapGrid2D::RefreshFreeCell(int32 X, int32 Y)
+{
+    const int32 Zone = ZoneIds.Get(X, Y);
+    if (Zone < 0 || Zone >= ZoneFreeCells.Num()) return; // zone not tracked yet
+
+    const bool bFree = ObjectDurability.Get(X, Y) <= 0 && !Occupants.Contains(Index(X, Y));
+    if (FreeBits.Get(X, Y) == bFree) return;
+    FreeBits.Set(X, Y, bFree);
+
+    if (bFree)
+    {
+        ++ZoneNumFree[Zone];
+        if (!FreeListed.Get(X, Y))
+        {
+            FreeListed.Set(X, Y, true);
+            ZoneFreeCells[Zone].Add(Index(X, Y));
+        }
+        return;
+    }
+
+    // The entry stays in the list; compact once stale entries outnumber live ones
+    --ZoneNumFree[Zone];
+    if (ZoneFreeCells[Zone].Num() > 2 * ZoneNumFree[Zone] + 64)
+    {
+        CompactFreeList(Zone);
+    }
+}
+
+void UMapGrid2D::RemoveFromFreeList(int32 X, int32 Y)
+{
+    const int32 Zone = ZoneIds.Get(X, Y);
+    if (Zone < 0 || Zone >= ZoneFreeCells.Num()) return;
+
+    if (FreeBits.Get(X, Y))
+    {
+        FreeBits.Set(X, Y, false);
+        --ZoneNumFree[Zone];
+    }
+    if (FreeListed.Get(X, Y))
+    {
+        // Linear, but zone moves are rare outside bulk relabels (which rebuild the index)
+        FreeListed.Set(X, Y, false);
+        ZoneFreeCells[Zone].RemoveSingleSwap(Index(X, Y), EAllowShrinking::No);
+    }
+}
+
+void UMapGrid2D::CompactFreeList(int32 InZoneId)
+{
+    TArray<int32>& List = ZoneFreeCells[InZoneId];
+    int32 NumKept = 0;
+    for (const int32 id : List)
+    {
+        const int32 X = id % SizeX;
+        const int32 Y = id / SizeX;
+        if (FreeBits.Get(X, Y))
+        {
+            List[NumKept++] = id;
+        }
+        else
+        {
+            FreeListed.Set(X, Y, false);
+        }
+    }
+    List.SetNum(NumKept, EAllowShrinking::No);
 }
 
 bool UMapGrid2D::RemoveObjectAt(int32 X, int32 Y)
 {
     if (!IsInBounds(X, Y)) return false;
-    FMapCell& Cell = Cells[Index(X, Y)];
-    Cell.ObjectTag = FGameplayTag();
-    Cell.ObjectDurability = 0;
+    WriteObject(X, Y, 0, 0);
     return true;
 }
 
 bool UMapGrid2D::GetBackgroundAt(int32 X, int32 Y, FGameplayTag& OutBackgroundTag) const
 {
     if (!IsInBounds(X, Y)) return false;
-    OutBackgroundTag = Cells[Index(X, Y)].BackgroundTag;
+    OutBackgroundTag = GetTagById(BackgroundIds.Get(X, Y));
     return true;
 }
 
@@ -68,74 +303,184 @@ bool UMapGrid2D::GetObjectAt(int32 X, int32 Y, FGameplayTag& OutObjectTag, int32
 {
     if (!IsInBounds(X, Y)) return false;
 
-    const FMapCell& Cell = Cells[Index(X, Y)];
-    if (!Cell.HasObject())
+    const int32 Dur = ObjectDurability.Get(X, Y);
+    if (Dur <= 0)
     {
         return false; // no object present
     }
 
-    OutObjectTag = Cell.ObjectTag;
-    OutDurability = Cell.ObjectDurability;
+    OutObjectTag = GetTagById(ObjectIds.Get(X, Y));
+    OutDurability = Dur;
     return true;
 }
 
+bool UMapGrid2D::HasObjectAt(int32 X, int32 Y) const
+{
+    // Setters keep tag and durability in sync, so durability alone decides presence
+    return IsInBounds(X, Y) && ObjectDurability.Get(X, Y) > 0;
+}
+
 bool UMapGrid2D::SetOreAt(int32 X, int32 Y, const FGameplayTag& InOreTag)
 {
     if (!IsInBounds(X, Y)) return false;
-    FMapCell& Cell = Cells[Index(X, Y)];
-    Cell.OreTag = InOreTag;
+    const uint16 Id = InternTag(InOreTag);
+    if (OreIds.Get(X, Y) != Id) CountCellChanges(1);
+    OreIds.Set(X, Y, Id);
+    MarkDirty(X, Y);
     return true;
 }
 
 bool UMapGrid2D::GetOreAt(int32 X, int32 Y, FGameplayTag& OutOreTag) const
 {
     if (!IsInBounds(X, Y)) return false;
-    OutOreTag = Cells[Index(X, Y)].OreTag;
+    OutOreTag = GetTagById(OreIds.Get(X, Y));
     return true;
 }
 
 bool UMapGrid2D::SetActorAt(int32 X, int32 Y, ACellActor* InActor)
 {
     if (!IsInBounds(X, Y)) return false;
-    Cells[Index(X, Y)].Occupant = InActor;
+    const int32 id = Index(X, Y);
+    if (ACellActor* Previous = GetActorAt(X, Y))
+    {
+        if (Previous != InActor) Previous->ClearGridCell(this);
+    }
+    if (InActor)
+    {
+        Occupants.Add(id, InActor);
+        InActor->SetGridCell(this, FIntPoint(X, Y));
+    }
+    else
+    {
+        Occupants.Remove(id);
+    }
+    RefreshFreeCell(X, Y);
+    RefreshBlockedAt(X, Y);
+    MarkDirty(X, Y);
     return true;
 }
 
 ACellActor* UMapGrid2D::GetActorAt(int32 X, int32 Y) const
 {
     if (!IsInBounds(X, Y)) return nullptr;
-    return Cells[Index(X, Y)].Occupant.Get();
+    const TObjectPtr<ACellActor>* Found = Occupants.Find(Index(X, Y));
+    return Found ? Found->Get() : nullptr;
 }
 
 bool UMapGrid2D::GetCell(int32 X, int32 Y, FMapCell& OutCell) const
 {
     if (!IsInBounds(X, Y)) return false;
-    OutCell = Cells[Index(X, Y)];
+    OutCell.BackgroundTag = GetTagById(BackgroundIds.Get(X, Y));
+    OutCell.ObjectTag = GetTagById(ObjectIds.Get(X, Y));
+    OutCell.ObjectDurability = ObjectDurability.Get(X, Y);
+    OutCell.OreTag = GetTagById(OreIds.Get(X, Y));
+    OutCell.ZoneId = ZoneIds.Get(X, Y);
+    OutCell.bVieved = Viewed.Get(X, Y);
+    const TObjectPtr<ACellActor>* Found = Occupants.Find(Index(X, Y));
+    OutCell.Occupant = Found ? *Found : nullptr;
     return true;
 }
 
+void UMapGrid2D::ToMapCell(const FMapCellView& View, FMapCell& OutCell) const
+{
+    OutCell.BackgroundTag = GetTagById(View.BackgroundId);
+    OutCell.ObjectTag = GetTagById(View.ObjectId);
+    OutCell.ObjectDurability = View.Durability;
+    OutCell.OreTag = GetTagById(View.OreId);
+    OutCell.ZoneId = View.ZoneId;
+    OutCell.bVieved = View.bViewed;
+    OutCell.Occupant = View.Occupant;
+}
+
 bool UMapGrid2D::SetViewedAt(int32 X, int32 Y, bool bViewed)
 {
     if (!IsInBounds(X, Y)) return false;
-    FMapCell& Cell = Cells[Index(X, Y)];
-    const bool bWasViewed = Cell.bVieved;
-    Cell.bVieved = bViewed;
+    const bool bWasViewed = Viewed.Get(X, Y);
+    if (bWasViewed == bViewed) return true;
+    Viewed.Set(X, Y, bViewed);
+    BumpEpoch();
 
     // Fire event when a cell becomes viewed
     if (!bWasViewed && bViewed)
     {
-        if (Cell.Occupant)
+        if (ACellActor* Occupant = GetActorAt(X, Y))
         {
-            Cell.Occupant->OnCellSeen();
+            Occupant->OnCellSeen();
         }
     }
     return true;
 }
 
+bool UMapGrid2D::IsViewedAt(int32 X, int32 Y) const
+{
+    return IsInBounds(X, Y) && Viewed.Get(X, Y);
+}
+
+int32 UMapGrid2D::MarkDiscViewed(FIntPoint Center, int32 Radius, TArray<FIntPoint>& OutNewlySeen)
+{
+    Radius = FMath::Max(0, Radius);
+
+    // Row half-widths only depend on the radius; vision uses a fixed radius so this is cached
+    if (DiscHalfWidthsRadius != Radius)
+    {
+        DiscHalfWidths.SetNumUninitialized(Radius + 1);
+        const int64 R2 = int64(Radius) * Radius;
+        for (int32 dy = 0; dy <= Radius; ++dy)
+        {
+            const int64 Rem = R2 - int64(dy) * dy;
+            int32 HW = static_cast<int32>(FMath::Sqrt(static_cast<double>(Rem)));
+            while (int64(HW) * HW > Rem) --HW;
+            while (int64(HW + 1) * (HW + 1) <= Rem) ++HW;
+            DiscHalfWidths[dy] = HW;
+        }
+        DiscHalfWidthsRadius = Radius;
+    }
+
+    const int32 Y0 = FMath::Max(0, Center.Y - Radius);
+    const int32 Y1 = FMath::Min(SizeY - 1, Center.Y + Radius);
+    const bool bAnyOccupants = Occupants.Num() > 0;
+    int32 NumNew = 0;
+
+    for (int32 y = Y0; y <= Y1; ++y)
+    {
+        const int32 HW = DiscHalfWidths[FMath::Abs(y - Center.Y)];
+        const int32 X0 = FMath::Max(0, Center.X - HW);
+        const int32 X1 = FMath::Min(SizeX - 1, Center.X + HW);
+        if (X0 > X1) continue;
+
+        NumNew += Viewed.SetSpan(y, X0, X1, [&](int32 x)
+        {
+            OutNewlySeen.Add(FIntPoint(x, y));
+            if (bAnyOccupants)
+            {
+                if (const TObjectPtr<ACellActor>* Found = Occupants.Find(Index(x, y)))
+                {
+                    if (*Found) (*Found)->OnCellSeen();
+                }
+            }
+        });
+    }
+    if (NumNew > 0) BumpEpoch();
+    return NumNew;
+}
+
 bool UMapGrid2D::SetZoneAt(int32 X, int32 Y, int32 InZoneId)
 {
     if (!IsInBounds(X, Y)) return false;
-    Cells[Index(X, Y)].ZoneId = InZoneId;
+    if (ZoneIds.Get(X, Y) == InZoneId) return true;
+
+    // Move the cell between free lists; the CSR index can only be rebuilt in bulk
+    RemoveFromFreeList(X, Y);
+    ZoneIds.Set(X, Y, InZoneId);
+    CountCellChanges(1);
+    if (InZoneId >= ZoneFreeCells.Num())
+    {
+        ZoneFreeCells.SetNum(InZoneId + 1);
+        ZoneNumFree.SetNumZeroed(InZoneId + 1);
+    }
+    RefreshFreeCell(X, Y);
+    bZoneIndexValid = false;
+    BumpEpoch();
     return true;
 }
 
@@ -143,29 +488,178 @@ bool UMapGrid2D::ApplyZoneLabels(const TArray<int32>& Labels)
 {
     const int32 N = SizeX * SizeY;
     if (Labels.Num() != N) return false;
-    for (int32 i = 0; i < N; ++i)
+    uint64 NumChanged = 0;
+    ForEachCellInRect<EMapCellField::Zone>(FIntRect(0, 0, SizeX, SizeY), [&](const FMapCellView& V)
     {
-        Cells[i].ZoneId = Labels[i];
-    }
+        NumChanged += V.ZoneId != Labels[Index(V.X, V.Y)];
+    });
+    ZoneIds.Assign(Labels.GetData());
+    CountCellChanges(NumChanged);
+    BumpEpoch();
+    RebuildZoneIndex();
     return true;
 }
 
+void UMapGrid2D::RebuildZoneIndex()
+{
+    // Pass 1: zone sizes and bounds
+    int32 NumZones = 0;
+    TArray<int32> Counts;
+    TArray<FIntPoint> Mins, Maxs;
+    ForEachCellInRect<EMapCellField::Zone>(FIntRect(0, 0, SizeX, SizeY), [&](const FMapCellView& V)
+    {
+        if (V.ZoneId < 0) return;
+        if (V.ZoneId >= NumZones)
+        {
+            NumZones = V.ZoneId + 1;
+            Counts.SetNumZeroed(NumZones);
+            Mins.SetNum(NumZones, EAllowShrinking::No);
+            Maxs.SetNum(NumZones, EAllowShrinking::No);
+        }
+        if (Counts[V.ZoneId]++ == 0)
+        {
+            Mins[V.ZoneId] = Maxs[V.ZoneId] = FIntPoint(V.X, V.Y);
+        }
+        else
+        {
+            Mins[V.ZoneId] = Mins[V.ZoneId].ComponentMin(FIntPoint(V.X, V.Y));
+            Maxs[V.ZoneId] = Maxs[V.ZoneId].ComponentMax(FIntPoint(V.X, V.Y));
+        }
+    });
+
+    ZoneCellStart.SetNumUninitialized(NumZones + 1);
+    ZoneBounds.SetNum(NumZones);
+    ZoneCellStart[0] = 0;
+    for (int32 z = 0; z < NumZones; ++z)
+    {
+        ZoneCellStart[z + 1] = ZoneCellStart[z] + Counts[z];
+        ZoneBounds[z] = Counts[z] > 0 ? FIntRect(Mins[z], Maxs[z] + FIntPoint(1, 1)) : FIntRect();
+    }
+
+    // Pass 2: scatter cell indices (row-major within each zone) and collect free cells
+    ZoneCellIndices.SetNumUninitialized(ZoneCellStart[NumZones]);
+    TArray<int32> Cursor(ZoneCellStart.GetData(), NumZones);
+    ZoneFreeCells.SetNum(NumZones);
+    for (int32 z = 0; z < NumZones; ++z)
+    {
+        ZoneFreeCells[z].Reset(Counts[z]);
+    }
+    ZoneNumFree.Reset();
+    ZoneNumFree.SetNumZeroed(NumZones);
+    FreeBits.Init(SizeX, SizeY);
+    FreeListed.Init(SizeX, SizeY);
+
+    const bool bAnyOccupants = Occupants.Num() > 0;
+    ForEachCellInRect<EMapCellField::Zone | EMapCellField::Durability>(FIntRect(0, 0, SizeX, SizeY), [&](const FMapCellView& V)
+    {
+        if (V.ZoneId < 0) return;
+        const int32 id = Index(V.X, V.Y);
+        ZoneCellIndices[Cursor[V.ZoneId]++] = id;
+        if (!V.HasObject() && !(bAnyOccupants && Occupants.Contains(id)))
+        {
+            ZoneFreeCells[V.ZoneId].Add(id);
+            ++ZoneNumFree[V.ZoneId];
+            FreeBits.Set(V.X, V.Y, true);
+            FreeListed.Set(V.X, V.Y, true);
+        }
+    });
+
+    bZoneIndexValid = true;
+}
+
+FIntRect UMapGrid2D::GetZoneBounds(int32 InZoneId) const
+{
+    return ZoneBounds.IsValidIndex(InZoneId) ? ZoneBounds[InZoneId] : FIntRect();
+}
+
+int32 UMapGrid2D::GetNumFreeCellsInZone(int32 InZoneId) const
+{
+    return ZoneNumFree.IsValidIndex(InZoneId) ? ZoneNumFree[InZoneId] : 0;
+}
+
+template <typename RandFuncType>
+bool UMapGrid2D::PickFreeCell(int32 InZoneId, RandFuncType&& RandIndex, FIntPoint& OutCell) const
+{
+    if (GetNumFreeCellsInZone(InZoneId) == 0) return false;
+
+    // Every free cell is listed and compaction keeps stale entries from dominating, so this terminates quickly
+    const TArray<int32>& List = ZoneFreeCells[InZoneId];
+    for (;;)
+    {
+        const FIntPoint Cell = IndexToCell(List[RandIndex(List.Num())]);
+        if (FreeBits.Get(Cell.X, Cell.Y))
+        {
+            OutCell = Cell;
+            return true;
+        }
+    }
+}
+
+bool UMapGrid2D::GetRandomFreeCellInZone(int32 InZoneId, FIntPoint& OutCell) const
+{
+    return PickFreeCell(InZoneId, [](int32 Num) { return FMath::RandRange(0, Num - 1); }, OutCell);
+}
+
+bool UMapGrid2D::SampleFreeCellInZone(int32 InZoneId, const FRandomStream& RNG, FIntPoint& OutCell) const
+{
+    return PickFreeCell(InZoneId, [&RNG](int32 Num) { return RNG.RandRange(0, Num - 1); }, OutCell);
+}
+
+TArrayView<const int32> UMapGrid2D::GetZoneCellIndices(int32 InZoneId) const
+{
+    if (!bZoneIndexValid || InZoneId < 0 || InZoneId + 1 >= ZoneCellStart.Num()) return {};
+    const int32 Start = ZoneCellStart[InZoneId];
+    return TArrayView<const int32>(ZoneCellIndices.GetData() + Start, ZoneCellStart[InZoneId + 1] - Start);
+}
+
+void UMapGrid2D::GetFreeCellIndicesInZone(int32 InZoneId, TArray<int32>& OutIndices) const
+{
+    if (!ZoneFreeCells.IsValidIndex(InZoneId)) return;
+    OutIndices.Reserve(OutIndices.Num() + ZoneNumFree[InZoneId]);
+    for (const int32 id : ZoneFreeCells[InZoneId])
+    {
+        if (FreeBits.Get(id % SizeX, id / SizeX))
+        {
+            OutIndices.Add(id);
+        }
+    }
+}
+
 int32 UMapGrid2D::GetZoneAt(int32 X, int32 Y) const
 {
     if (!IsInBounds(X, Y)) return -1;
-    return Cells[Index(X, Y)].ZoneId;
+    return ZoneIds.Get(X, Y);
 }
 
 TArray<FIntPoint> UMapGrid2D::GetCellsForZone(int32 InZoneId) const
 {
     TArray<FIntPoint> Result;
+    if (bZoneIndexValid)
+    {
+        const TArrayView<const int32> Cells = GetZoneCellIndices(InZoneId);
+        Result.Reserve(Cells.Num());
+        for (const int32 id : Cells)
+        {
+            Result.Add(IndexToCell(id));
+        }
+        return Result;
+    }
+
     Result.Reserve(SizeX * SizeY / 4);
-    for (int32 y = 0; y < SizeY; ++y)
+    // Stale index: scan the zone plane, taking or skipping uniform tiles whole
+    const FIntPoint NumChunks = ZoneIds.GetNumChunks();
+    for (int32 cy = 0; cy < NumChunks.Y; ++cy)
+    for (int32 cx = 0; cx < NumChunks.X; ++cx)
     {
-        for (int32 x = 0; x < SizeX; ++x)
+        const FIntRect R = ZoneIds.GetChunkRect(cx, cy);
+        int32 UniformZone = -1;
+        const bool bUniform = ZoneIds.IsChunkUniform(cx, cy, UniformZone);
+        if (bUniform && UniformZone != InZoneId) continue;
+
+        for (int32 y = R.Min.Y; y < R.Max.Y; ++y)
+        for (int32 x = R.Min.X; x < R.Max.X; ++x)
         {
-            const int32 id = Index(x, y);
-            if (Cells[id].ZoneId == InZoneId)
+            if (bUniform || ZoneIds.Get(x, y) == InZoneId)
             {
                 Result.Add(FIntPoint(x, y));
             }
@@ -183,3 +677,285 @@ TArray<FRoomInfo> UMapGrid2D::GetRoomsForZone(int32 InZoneId) const
     }
     return Out;
 }
+
+FMapGridSnapshotRef UMapGrid2D::CreateSnapshot() const
+{
+    if (TSharedPtr<const FMapGridSnapshot, ESPMode::ThreadSafe> Cached = CachedSnapshot.Pin())
+    {
+        if (Cached->GetEpoch() == GetEpoch())
+        {
+            return Cached.ToSharedRef();
+        }
+    }
+
+    // Plane copies only bump reference counts on the shared cell arrays
+    TSharedRef<FMapGridSnapshot, ESPMode::ThreadSafe> Snap = MakeShared<FMapGridSnapshot, ESPMode::ThreadSafe>();
+    Snap->Epoch = GetEpoch();
+    Snap->SizeX = SizeX;
+    Snap->SizeY = SizeY;
+    Snap->BackgroundIds = BackgroundIds;
+    Snap->ObjectIds = ObjectIds;
+    Snap->ObjectDurability = ObjectDurability;
+    Snap->OreIds = OreIds;
+    Snap->ZoneIds = ZoneIds;
+    Snap->Viewed = Viewed;
+    Snap->Blocked = Blocked;
+    Snap->Palette = Palette;
+    Snap->ZoneDepths = ZoneDepths;
+
+    CachedSnapshot = Snap;
+    return Snap;
+}
+
+void UMapGrid2D::CreateCheckpoint(FMapGridCheckpoint& Out) const
+{
+    Out.Cells = CreateSnapshot();
+    Out.Rooms = Rooms;
+    Out.Passages = Passages;
+    Out.bChunked = BackgroundIds.IsChunked();
+}
+
+void UMapGrid2D::RestoreCheckpoint(const FMapGridCheckpoint& Checkpoint)
+{
+    if (!Checkpoint.IsValid()) return;
+    const FMapGridSnapshot& Snap = *Checkpoint.Cells;
+
+    // Plane copies share the checkpoint's storage; writes after this clone what they touch
+    Initialize(Snap.SizeX, Snap.SizeY, Checkpoint.bChunked);
+    Palette = Snap.Palette;
+    for (int32 i = 1; i < Palette.Num(); ++i)
+    {
+        if (Palette[i].IsValid()) PaletteLookup.Add(Palette[i], static_cast<uint16>(i));
+    }
+    BackgroundIds = Snap.BackgroundIds;
+    ObjectIds = Snap.ObjectIds;
+    ObjectDurability = Snap.ObjectDurability;
+    OreIds = Snap.OreIds;
+    ZoneIds = Snap.ZoneIds;
+    Viewed = Snap.Viewed;
+    ZoneDepths = Snap.ZoneDepths;
+    Rooms = Checkpoint.Rooms;
+    Passages = Checkpoint.Passages;
+
+    // Snapshot blocked bits may include occupants, which are not restored
+    for (int32 y = 0; y < SizeY; ++y)
+    for (int32 x = 0; x < SizeX; ++x)
+    {
+        if (ObjectDurability.Get(x, y) > 0) Blocked.Set(x, y, true);
+    }
+    RebuildZoneIndex();
+    BumpEpoch();
+}
+
+void UMapGrid2D::GetAllCellActors(TArray<ACellActor*>& OutActors) const
+{
+    OutActors.Reset(Occupants.Num());
+    for (const TPair<int32, TObjectPtr<ACellActor>>& Pair : Occupants)
+    {
+        if (Pair.Value) OutActors.Add(Pair.Value);
+    }
+}
+
+void UMapGrid2D::SaveToBytes(TArray<uint8>& OutBytes) const
+{
+    TArray<uint8> Payload;
+    FMemoryWriter Ar(Payload);
+
+    int32 SX = SizeX;
+    int32 SY = SizeY;
+    bool bChunked = BackgroundIds.IsChunked();
+    Ar << SX << SY << bChunked;
+
+    // Palette by tag name so ids survive tag table changes between builds
+    int32 NumTags = Palette.Num();
+    Ar << NumTags;
+    for (int32 i = 1; i < NumTags; ++i)
+    {
+        FName TagName = Palette[i].GetTagName();
+        Ar << TagName;
+    }
+
+    // Planes are only read when saving; SerializeRuns is non-const for the load path
+    const_cast<TMapGridPlane<uint16>&>(BackgroundIds).SerializeRuns(Ar);
+    const_cast<TMapGridPlane<uint16>&>(ObjectIds).SerializeRuns(Ar);
+    const_cast<TMapGridPlane<int32>&>(ObjectDurability).SerializeRuns(Ar);
+    const_cast<TMapGridPlane<uint16>&>(OreIds).SerializeRuns(Ar);
+    const_cast<TMapGridPlane<int32>&>(ZoneIds).SerializeRuns(Ar);
+    const_cast<FMapGridBitPlane&>(Viewed).Serialize(Ar);
+
+    MapGridSave::SerializeRooms(Ar, const_cast<TArray<FRoomInfo>&>(Rooms));
+    MapGridSave::SerializePassages(Ar, const_cast<TArray<FZonePassage>&>(Passages));
+    Ar << const_cast<TArray<int32>&>(ZoneDepths);
+
+    // Occupants in cell order so identical maps produce identical files
+    TArray<int32> OccupiedCells;
+    for (const TPair<int32, TObjectPtr<ACellActor>>& Pair : Occupants)
+    {
+        if (Pair.Value) OccupiedCells.Add(Pair.Key);
+    }
+    OccupiedCells.Sort();
+
+    int32 NumActors = OccupiedCells.Num();
+    Ar << NumActors;
+    for (const int32 id : OccupiedCells)
+    {
+        ACellActor* Actor = Occupants.FindRef(id);
+        FMapCellActorRecord Rec;
+        Rec.ClassPath = Actor->GetClass()->GetPathName();
+        Rec.Cell = FIntPoint(id % SizeX, id / SizeX);
+        Rec.Location = Actor->GetActorLocation();
+        FMemoryWriter StateAr(Rec.State);
+        Actor->SerializeCellState(StateAr);
+
+        Ar << Rec.ClassPath << Rec.Cell << Rec.Location << Rec.State;
+    }
+
+    // Header: magic, version, uncompressed size, compressed size, then the Zlib payload
+    int32 UncompressedSize = Payload.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Payload.GetData(), UncompressedSize))
+    {
+        OutBytes.Reset();
+        return;
+    }
+
+    OutBytes.Reset(CompressedSize + 16);
+    FMemoryWriter Out(OutBytes);
+    uint32 MagicValue = MapGridSave::Magic;
+    int32 VersionValue = MapGridSave::Version;
+    Out << MagicValue << VersionValue << UncompressedSize << CompressedSize;
+    Out.Serialize(Compressed.GetData(), CompressedSize);
+}
+
+bool UMapGrid2D::LoadFromBytes(const TArray<uint8>& InBytes, TArray<FMapCellActorRecord>& OutActors)
+{
+    OutActors.Reset();
+
+    FMemoryReader In(InBytes);
+    uint32 MagicValue = 0;
+    int32 VersionValue = 0, UncompressedSize = 0, CompressedSize = 0;
+    In << MagicValue << VersionValue << UncompressedSize << CompressedSize;
+    if (In.IsError() || MagicValue != MapGridSave::Magic || VersionValue != MapGridSave::Version) return false;
+    if (UncompressedSize <= 0 || UncompressedSize > MapGridSave::MaxUncompressedSize) return false;
+    if (CompressedSize <= 0 || CompressedSize != InBytes.Num() - In.Tell()) return false;
+
+    TArray<uint8> Payload;
+    Payload.SetNumUninitialized(UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), UncompressedSize, InBytes.GetData() + In.Tell(), CompressedSize))
+    {
+        return false;
+    }
+
+    // Parse into locals first so a malformed payload leaves the map untouched
+    FMemoryReader Ar(Payload);
+    int32 SX = 0, SY = 0;
+    bool bChunked = false;
+    Ar << SX << SY << bChunked;
+    if (Ar.IsError() || SX <= 0 || SY <= 0 || int64(SX) * SY > MapGridSave::MaxUncompressedSize) return false;
+
+    int32 NumTags = 0;
+    Ar << NumTags;
+    if (Ar.IsError() || NumTags < 1 || NumTags > MAX_uint16 + 1) return false;
+    TArray<FGameplayTag> NewPalette;
+    NewPalette.Reserve(NumTags);
+    NewPalette.Add(FGameplayTag());
+    bool bAnyTagMissing = false;
+    for (int32 i = 1; i < NumTags && !Ar.IsError(); ++i)
+    {
+        FName TagName;
+        Ar << TagName;
+        // Tags removed from the project load as empty; their cells are cleared below
+        NewPalette.Add(FGameplayTag::RequestGameplayTag(TagName, /*ErrorIfNotFound*/ false));
+        bAnyTagMissing |= !NewPalette.Last().IsValid();
+    }
+
+    TMapGridPlane<uint16> NewBackground, NewObjects, NewOres;
+    TMapGridPlane<int32> NewDurability, NewZones;
+    FMapGridBitPlane NewViewed;
+    NewBackground.Init(SX, SY, 0, bChunked);
+    NewObjects.Init(SX, SY, 0, bChunked);
+    NewDurability.Init(SX, SY, 0, bChunked);
+    NewOres.Init(SX, SY, 0, bChunked);
+    NewZones.Init(SX, SY, -1, bChunked);
+    NewViewed.Init(SX, SY);
+    NewBackground.SerializeRuns(Ar);
+    NewObjects.SerializeRuns(Ar);
+    NewDurability.SerializeRuns(Ar);
+    NewOres.SerializeRuns(Ar);
+    NewZones.SerializeRuns(Ar);
+    NewViewed.Serialize(Ar);
+
+    TArray<FRoomInfo> NewRooms;
+    TArray<FZonePassage> NewPassages;
+    TArray<int32> NewDepths;
+    MapGridSave::SerializeRooms(Ar, NewRooms);
+    MapGridSave::SerializePassages(Ar, NewPassages);
+    int32 NumDepths = 0;
+    Ar << NumDepths;
+    if (Ar.IsError() || NumDepths < 0 || NumDepths > SX * SY) return false; // at most one zone per cell
+    NewDepths.SetNumUninitialized(NumDepths);
+    for (int32& Depth : NewDepths)
+    {
+        Ar << Depth;
+    }
+
+    int32 NumActors = 0;
+    Ar << NumActors;
+    if (Ar.IsError() || NumActors < 0 || NumActors > SX * SY) return false;
+    OutActors.SetNum(NumActors);
+    for (FMapCellActorRecord& Rec : OutActors)
+    {
+        Ar << Rec.ClassPath << Rec.Cell << Rec.Location << Rec.State;
+    }
+    if (Ar.IsError())
+    {
+        OutActors.Reset();
+        return false;
+    }
+
+    // Cells whose tag no longer exists become empty: an object keeps tag and durability in sync
+    // (see WriteObject), so a blocking object without a tag must not survive the load
+    if (bAnyTagMissing)
+    {
+        auto IsMissing = [&](uint16 Id) { return Id != 0 && (Id >= NewPalette.Num() || !NewPalette[Id].IsValid()); };
+        for (int32 id = 0; id < SX * SY; ++id)
+        {
+            if (IsMissing(NewObjects[id]))
+            {
+                NewObjects.SetIndex(id, 0);
+                NewDurability.SetIndex(id, 0);
+            }
+            if (IsMissing(NewBackground[id])) NewBackground.SetIndex(id, 0);
+            if (IsMissing(NewOres[id])) NewOres.SetIndex(id, 0);
+        }
+    }
+
+    // Commit: reset to the saved size, then move the parsed planes in
+    Initialize(SX, SY, bChunked);
+    Palette = MoveTemp(NewPalette);
+    for (int32 i = 1; i < Palette.Num(); ++i)
+    {
+        if (Palette[i].IsValid()) PaletteLookup.Add(Palette[i], static_cast<uint16>(i));
+    }
+    BackgroundIds = MoveTemp(NewBackground);
+    ObjectIds = MoveTemp(NewObjects);
+    ObjectDurability = MoveTemp(NewDurability);
+    OreIds = MoveTemp(NewOres);
+    ZoneIds = MoveTemp(NewZones);
+    Viewed = MoveTemp(NewViewed);
+    Rooms = MoveTemp(NewRooms);
+    Passages = MoveTemp(NewPassages);
+    ZoneDepths = MoveTemp(NewDepths);
+
+    // Derived state: blocked bits from objects (occupants refresh theirs when placed), zone index and free lists
+    for (int32 y = 0; y < SizeY; ++y)
+    for (int32 x = 0; x < SizeX; ++x)
+    {
+        if (ObjectDurability.Get(x, y) > 0) Blocked.Set(x, y, true);
+    }
+    RebuildZoneIndex();
+    BumpEpoch();
+    return true;
+}
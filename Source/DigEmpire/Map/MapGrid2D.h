@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "GameplayTagContainer.h"
+#include "MapGridStorage.h"
+#include "MapGridSnapshot.h"
+#include <atomic>
 #include "Generation/ZonePassageTypes.h" // FZonePassage
 #include "Rooms/RoomTypes.h"                // FRoomInfo
 #include "MapGrid2D.generated.h"
@@ -50,9 +53,108 @@ struct FMapCell
     FGameplayTag OreTag;
 };
 
+/**
+ * Set of palette ids for one map, one bit per id.
+ * Built once from a tag list via UMapGrid2D::MakeTagMask; Contains is a single bit test.
+ */
+struct FMapTagMask
+{
+    TArray<uint64> Words;
+
+    void Add(uint16 Id)
+    {
+        const int32 Word = Id >> 6;
+        if (Word >= Words.Num()) Words.SetNumZeroed(Word + 1);
+        Words[Word] |= (uint64(1) << (Id & 63));
+    }
+
+    bool Contains(uint16 Id) const
+    {
+        const int32 Word = Id >> 6;
+        return Word < Words.Num() && (Words[Word] & (uint64(1) << (Id & 63))) != 0;
+    }
+
+    bool IsEmpty() const { return Words.Num() == 0; }
+};
+
+/** Cell fields a visitor wants; combine as the template argument of UMapGrid2D::ForEachCellInRect. */
+namespace EMapCellField
+{
+    enum Type : uint32
+    {
+        None       = 0,
+        Background = 1 << 0,
+        Object     = 1 << 1, // object palette id
+        Durability = 1 << 2,
+        Ore        = 1 << 3,
+        Zone       = 1 << 4,
+        Viewed     = 1 << 5,
+        Occupant   = 1 << 6,
+        All        = (1 << 7) - 1
+    };
+}
+
+/**
+ * Cell handed to ForEachCellInRect visitors. Only the requested fields are filled;
+ * tags are palette ids (resolve with UMapGrid2D::GetTagById or ToMapCell).
+ */
+struct FMapCellView
+{
+    int32 X = 0;
+    int32 Y = 0;
+    uint16 BackgroundId = 0;
+    uint16 ObjectId = 0;
+    uint16 OreId = 0;
+    int32 Durability = 0;
+    int32 ZoneId = -1;
+    bool bViewed = false;
+    ACellActor* Occupant = nullptr;
+
+    bool HasObject() const { return Durability > 0; }
+};
+
+/**
+ * Saved cell actor occupant (see UMapGrid2D::SaveToBytes). The grid only records it;
+ * spawning is up to the owner (UMapGrid2DComponent::LoadMapFromBytes).
+ */
+struct FMapCellActorRecord
+{
+    /** Class path of the actor (UClass::GetPathName) */
+    FString ClassPath;
+
+    /** Occupied cell */
+    FIntPoint Cell = FIntPoint::ZeroValue;
+
+    /** World location at save time */
+    FVector Location = FVector::ZeroVector;
+
+    /** Output of ACellActor::SerializeCellState */
+    TArray<uint8> State;
+};
+
+/**
+ * Generation state of a UMapGrid2D at one point in time (see UMapGrid2D::CreateCheckpoint).
+ * Cell planes are shared copy-on-write with the grid, so a checkpoint costs the tiles
+ * (or flat planes) written after it. Occupant actors are not included.
+ */
+struct FMapGridCheckpoint
+{
+    TSharedPtr<const FMapGridSnapshot, ESPMode::ThreadSafe> Cells;
+    TArray<FRoomInfo> Rooms;
+    TArray<FZonePassage> Passages;
+    bool bChunked = false;
+
+    bool IsValid() const { return Cells.IsValid(); }
+};
+
 /**
  * 2D map container object.
  * Stores an X*Y grid of cells with background and object data.
+ * Cell fields live in separate column planes (structure of arrays) so scans that
+ * only need one field touch only that field; FMapCell is assembled on demand by GetCell.
+ * Tag planes store dense uint16 ids into a per-map palette (id 0 = empty tag).
+ * Planes are either flat or chunked (see TMapGridPlane); chunked maps only allocate
+ * tiles that differ from their uniform fill value.
  */
 UCLASS(BlueprintType)
 class UMapGrid2D : public UObject
@@ -60,9 +162,20 @@ class UMapGrid2D : public UObject
 	GENERATED_BODY()
 
 public:
-	/** Create/Reinitialize the map with given size (clears content) */
+	/** Create/Reinitialize the map with given size (clears content). Chunked storage suits very large, mostly uniform maps. */
+	UFUNCTION(BlueprintCallable, Category="MapGrid")
+	void Initialize(int32 InSizeX, int32 InSizeY, bool bChunkedStorage = false);
+
+	/** Set the background of every cell (chunked maps stay unallocated) */
+	UFUNCTION(BlueprintCallable, Category="MapGrid")
+	void FillBackground(const FGameplayTag& BackgroundTag);
+
+	/** Release chunk tiles that became uniform again. Returns released tile count (0 for flat maps). */
 	UFUNCTION(BlueprintCallable, Category="MapGrid")
-	void Initialize(int32 InSizeX, int32 InSizeY);
+	int32 CompactStorage();
+
+	UFUNCTION(BlueprintPure, Category="MapGrid")
+	bool IsChunkedStorage() const { return ZoneIds.IsChunked(); }
 
 	/** Map size */
 	UFUNCTION(BlueprintPure, Category="MapGrid")
@@ -88,6 +201,10 @@ public:
     UFUNCTION(BlueprintPure, Category="MapGrid")
     bool GetObjectAt(int32 X, int32 Y, FGameplayTag& OutObjectTag, int32& OutDurability) const;
 
+    /** Quick predicate: does the cell have an object? (false if out of bounds). Reads only the durability plane. */
+    UFUNCTION(BlueprintPure, Category="MapGrid")
+    bool HasObjectAt(int32 X, int32 Y) const;
+
     /** Set ore tag at a cell (empty tag clears ore). */
     UFUNCTION(BlueprintCallable, Category="MapGrid|Ore")
     bool SetOreAt(int32 X, int32 Y, const FGameplayTag& InOreTag);
@@ -104,27 +221,305 @@ public:
     UFUNCTION(BlueprintPure, Category="MapGrid")
     ACellActor* GetActorAt(int32 X, int32 Y) const;
 
-    /** Fast access to a whole cell (false if out of bounds) */
+    /** Is the cell impassable: a blocking occupant, or an object when there is no occupant (false if OOB). One bit read. */
+    UFUNCTION(BlueprintPure, Category="MapGrid")
+    bool IsBlockedAt(int32 X, int32 Y) const
+    {
+        return IsInBounds(X, Y) && Blocked.Get(X, Y);
+    }
+
+    /** Re-evaluate the blocked bit of a cell (called by occupants whose IsBlocked() changed, e.g. doors opening). */
+    UFUNCTION(BlueprintCallable, Category="MapGrid")
+    void RefreshBlockedAt(int32 X, int32 Y);
+
+    /** Whole-cell access (false if out of bounds). Assembles an FMapCell from the column planes. */
     UFUNCTION(BlueprintPure, Category="MapGrid")
     bool GetCell(int32 X, int32 Y, FMapCell& OutCell) const;
 
+    /** Resolve a visitor view into a full FMapCell (fields the view did not request stay default). */
+    void ToMapCell(const FMapCellView& View, FMapCell& OutCell) const;
+
+    /**
+     * Visit every cell of Rect (Max exclusive) in row-major order. Rect is clipped to the map once;
+     * Fields (EMapCellField flags) selects at compile time which planes are read.
+     * Visitor signature: void(const FMapCellView&).
+     */
+    template<uint32 Fields, typename FuncType>
+    void ForEachCellInRect(const FIntRect& Rect, FuncType&& Visitor) const
+    {
+        const int32 X0 = FMath::Max(0, Rect.Min.X), X1 = FMath::Min(SizeX, Rect.Max.X);
+        const int32 Y0 = FMath::Max(0, Rect.Min.Y), Y1 = FMath::Min(SizeY, Rect.Max.Y);
+        const bool bAnyOccupants = Occupants.Num() > 0;
+        FMapCellView V;
+        for (int32 y = Y0; y < Y1; ++y)
+        {
+            // Flat storage hands out row pointers; chunked storage falls back to per-cell Get
+            const uint16* BgRow = BackgroundIds.GetRowData(y);
+            const uint16* ObjRow = ObjectIds.GetRowData(y);
+            const int32* DurRow = ObjectDurability.GetRowData(y);
+            const uint16* OreRow = OreIds.GetRowData(y);
+            const int32* ZoneRow = ZoneIds.GetRowData(y);
+            V.Y = y;
+            for (int32 x = X0; x < X1; ++x)
+            {
+                V.X = x;
+                if constexpr ((Fields & EMapCellField::Background) != 0) V.BackgroundId = BgRow ? BgRow[x] : BackgroundIds.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Object) != 0)     V.ObjectId = ObjRow ? ObjRow[x] : ObjectIds.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Durability) != 0) V.Durability = DurRow ? DurRow[x] : ObjectDurability.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Ore) != 0)        V.OreId = OreRow ? OreRow[x] : OreIds.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Zone) != 0)       V.ZoneId = ZoneRow ? ZoneRow[x] : ZoneIds.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Viewed) != 0)     V.bViewed = Viewed.Get(x, y);
+                if constexpr ((Fields & EMapCellField::Occupant) != 0)
+                {
+                    const TObjectPtr<ACellActor>* Found = bAnyOccupants ? Occupants.Find(Index(x, y)) : nullptr;
+                    V.Occupant = Found ? Found->Get() : nullptr;
+                }
+                Visitor(static_cast<const FMapCellView&>(V));
+            }
+        }
+    }
+
+    /**
+     * Mutable variant: the visitor may change Background/Object/Durability/Ore/Zone fields of the
+     * view (only those requested in Fields); changed values are written back through the grid.
+     * An object id of 0 or durability <= 0 removes the object, as in AddOrUpdateObjectAt.
+     */
+    template<uint32 Fields, typename FuncType>
+    void ForEachCellInRectMutable(const FIntRect& Rect, FuncType&& Visitor)
+    {
+        constexpr uint32 ReadFields = Fields & ~(uint32)EMapCellField::Occupant;
+
+        // Rows are read through raw pointers: detach shared (snapshotted) storage before writing
+        if constexpr ((Fields & EMapCellField::Background) != 0) BackgroundIds.MakeUnique();
+        if constexpr ((Fields & EMapCellField::Object) != 0) ObjectIds.MakeUnique();
+        if constexpr ((Fields & (EMapCellField::Object | EMapCellField::Durability)) != 0) ObjectDurability.MakeUnique();
+        if constexpr ((Fields & EMapCellField::Ore) != 0) OreIds.MakeUnique();
+        if constexpr ((Fields & EMapCellField::Zone) != 0) ZoneIds.MakeUnique();
+
+        ForEachCellInRect<ReadFields>(Rect, [&](const FMapCellView& In)
+        {
+            FMapCellView V = In;
+            Visitor(V);
+            if constexpr ((Fields & EMapCellField::Background) != 0)
+            {
+                if (V.BackgroundId != In.BackgroundId)
+                {
+                    BackgroundIds.Set(V.X, V.Y, V.BackgroundId);
+                    CountCellChanges(1);
+                    MarkDirty(V.X, V.Y);
+                }
+            }
+            if constexpr ((Fields & (EMapCellField::Object | EMapCellField::Durability)) != 0)
+            {
+                if (V.ObjectId != In.ObjectId || V.Durability != In.Durability)
+                {
+                    const uint16 NewId = ((Fields & EMapCellField::Object) != 0) ? V.ObjectId : ObjectIds.Get(V.X, V.Y);
+                    const int32 NewDur = ((Fields & EMapCellField::Durability) != 0) ? V.Durability : ObjectDurability.Get(V.X, V.Y);
+                    WriteObject(V.X, V.Y, NewId, NewDur);
+                }
+            }
+            if constexpr ((Fields & EMapCellField::Ore) != 0)
+            {
+                if (V.OreId != In.OreId)
+                {
+                    OreIds.Set(V.X, V.Y, V.OreId);
+                    CountCellChanges(1);
+                    MarkDirty(V.X, V.Y);
+                }
+            }
+            if constexpr ((Fields & EMapCellField::Zone) != 0)
+            {
+                if (V.ZoneId != In.ZoneId)
+                {
+                    // Moves the cell between zone free lists and invalidates the CSR index
+                    SetZoneAt(V.X, V.Y, V.ZoneId);
+                }
+            }
+        });
+    }
+
     /** Mark or clear the viewed flag for a cell */
     UFUNCTION(BlueprintCallable, Category="MapGrid")
     bool SetViewedAt(int32 X, int32 Y, bool bViewed);
 
+    /** Has the cell been seen (false if out of bounds). */
+    UFUNCTION(BlueprintPure, Category="MapGrid")
+    bool IsViewedAt(int32 X, int32 Y) const;
+
+    /**
+     * Mark every in-bounds cell with dx*dx + dy*dy <= Radius*Radius around Center as viewed.
+     * Cells that were not viewed before are appended to OutNewlySeen (row-major) and their
+     * occupants get OnCellSeen. Works a 64-cell word at a time. Returns the number of new cells.
+     */
+    UFUNCTION(BlueprintCallable, Category="MapGrid")
+    int32 MarkDiscViewed(FIntPoint Center, int32 Radius, TArray<FIntPoint>& OutNewlySeen);
+
     // Zones API
+    /** Set one cell's zone. Keeps free-cell lists current but invalidates the zone cell index until RebuildZoneIndex. */
     UFUNCTION(BlueprintCallable, Category="MapGrid|Zones")
     bool SetZoneAt(int32 X, int32 Y, int32 InZoneId);
 
+    /** Set all zone ids at once and rebuild the zone cell index and free-cell lists. */
     UFUNCTION(BlueprintCallable, Category="MapGrid|Zones")
     bool ApplyZoneLabels(const TArray<int32>& Labels);
 
+    /** Rebuild the per-zone cell index, bounds and free-cell lists from the zone plane. */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Zones")
+    void RebuildZoneIndex();
+
     UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
     int32 GetZoneAt(int32 X, int32 Y) const;
 
     UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
     TArray<FIntPoint> GetCellsForZone(int32 InZoneId) const;
 
+    /** Number of zone ids covered by the index (max zone id + 1). */
+    UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
+    int32 GetNumZones() const { return ZoneBounds.Num(); }
+
+    /** Bounding rect of a zone (Max exclusive); empty rect if the zone has no cells. */
+    FIntRect GetZoneBounds(int32 InZoneId) const;
+
+    /** Number of cells in a zone without object or actor. */
+    UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
+    int32 GetNumFreeCellsInZone(int32 InZoneId) const;
+
+    /** Uniformly pick a cell in a zone without object or actor (false if none). */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Zones")
+    bool GetRandomFreeCellInZone(int32 InZoneId, FIntPoint& OutCell) const;
+
+    /** Same as GetRandomFreeCellInZone but driven by a caller's random stream. */
+    bool SampleFreeCellInZone(int32 InZoneId, const FRandomStream& RNG, FIntPoint& OutCell) const;
+
+    /** Cell indices (X + Y*SizeX) of a zone in row-major order. Empty if the index is stale or the zone unknown. */
+    TArrayView<const int32> GetZoneCellIndices(int32 InZoneId) const;
+
+    /** Cell indices of a zone's free cells (no object, no actor), unordered. */
+    void GetFreeCellIndicesInZone(int32 InZoneId, TArray<int32>& OutIndices) const;
+
+    bool IsZoneIndexValid() const { return bZoneIndexValid; }
+
+    /** Convert a flat cell index back to coordinates. */
+    FIntPoint IndexToCell(int32 InIndex) const { return FIntPoint(InIndex % SizeX, InIndex / SizeX); }
+
+    /** Read-only zone id plane (index = X + Y*SizeX). */
+    const TMapGridPlane<int32>& GetZonePlane() const { return ZoneIds; }
+
+    /** Read-only object durability plane (index = X + Y*SizeX); <=0 means no object. */
+    const TMapGridPlane<int32>& GetDurabilityPlane() const { return ObjectDurability; }
+
+    // Chunk API (C++). Flat maps expose the same tile layout, they just never report uniform tiles.
+
+    /** Number of tiles along X and Y */
+    FIntPoint GetNumChunks() const { return ZoneIds.GetNumChunks(); }
+
+    /** Cell rect of a tile, clipped to the map (Max exclusive) */
+    FIntRect GetChunkRect(int32 CX, int32 CY) const { return ZoneIds.GetChunkRect(CX, CY); }
+
+    /** True if every cell of the tile has zone OutZoneId */
+    bool IsZoneChunkUniform(int32 CX, int32 CY, int32& OutZoneId) const { return ZoneIds.IsChunkUniform(CX, CY, OutZoneId); }
+
+    /** True if the tile is known to hold no objects at all */
+    bool IsChunkFreeOfObjects(int32 CX, int32 CY) const
+    {
+        int32 Dur = 0;
+        return ObjectDurability.IsChunkUniform(CX, CY, Dur) && Dur <= 0;
+    }
+
+    // Change journal (C++). Background, object, ore and occupant writes record the cell once until consumed.
+
+    /** Enable/disable recording (disabling also discards pending changes). */
+    void SetChangeJournalEnabled(bool bEnabled);
+    bool IsChangeJournalEnabled() const { return bJournalEnabled; }
+
+    bool HasPendingChanges() const { return DirtyCells.Num() > 0; }
+
+    /** Move out the changed cell indices (X + Y*SizeX, first-change order) and reset the journal. */
+    void ConsumeChangedCells(TArray<int32>& OutIndices);
+
+    /** Drop pending changes (e.g. after a full rebuild makes them redundant). */
+    void DiscardChanges();
+
+    /** Bytes held by cell planes (excludes palette, rooms and passages) */
+    SIZE_T GetPlaneAllocatedSize() const;
+
+    // Tag palette API (C++)
+
+    /** Palette id for a tag, adding it if unseen. Empty tag is always id 0. */
+    uint16 InternTag(const FGameplayTag& Tag);
+
+    /** Palette id for a tag, or 0 if the tag never appeared in this map. */
+    uint16 FindTagId(const FGameplayTag& Tag) const;
+
+    /** Tag for a palette id (empty tag for 0 or unknown ids). */
+    const FGameplayTag& GetTagById(uint16 Id) const
+    {
+        return Palette.IsValidIndex(Id) ? Palette[Id] : Palette[0];
+    }
+
+    /** Precomputed id set for a tag list. Tags not yet in the palette cannot match any cell and are skipped. */
+    FMapTagMask MakeTagMask(const TArray<FGameplayTag>& Tags) const;
+
+    /** Object palette id at a cell (0 if no object or out of bounds). */
+    uint16 GetObjectIdAt(int32 X, int32 Y) const
+    {
+        return IsInBounds(X, Y) ? ObjectIds.Get(X, Y) : 0;
+    }
+
+    /** Read-only object id plane (index = X + Y*SizeX); 0 means no object. */
+    const TMapGridPlane<uint16>& GetObjectIdPlane() const { return ObjectIds; }
+
+    // Zone depth API (hop distance from zone 0 through passages; -1 = unreachable/unknown)
+    UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
+    int32 GetZoneDepth(int32 InZoneId) const { return ZoneDepths.IsValidIndex(InZoneId) ? ZoneDepths[InZoneId] : -1; }
+
+    void SetZoneDepths(const TArray<int32>& InDepths) { ZoneDepths = InDepths; BumpEpoch(); }
+    const TArray<int32>& GetZoneDepths() const { return ZoneDepths; }
+
+    // Snapshots (C++)
+
+    /**
+     * Read-only copy of the cell planes, palette and zone depths for use on other threads.
+     * O(tiles) to take: storage is shared with the grid, which clones what it writes next.
+     * Repeated calls without changes in between return the same snapshot.
+     * Call on the thread that owns the grid (the game thread for the live map).
+     */
+    FMapGridSnapshotRef CreateSnapshot() const;
+
+    /** Incremented by every content change; compare with FMapGridSnapshot::GetEpoch. */
+    uint64 GetEpoch() const { return Epoch.load(std::memory_order_relaxed); }
+
+    /** Cell value changes (background, object/durability, ore, zone) so far; writes that leave a cell as it was are not counted. */
+    uint64 GetCellChangeCount() const { return CellChanges.load(std::memory_order_relaxed); }
+
+    /** Capture the generation state (planes, palette, zone depths, rooms, passages) for RestoreCheckpoint. */
+    void CreateCheckpoint(FMapGridCheckpoint& Out) const;
+
+    /**
+     * Replace this map with a checkpoint. Occupants are dropped (not destroyed); derived state
+     * (blocked bits, zone index, free lists) is rebuilt and the viewed bits are restored too.
+     */
+    void RestoreCheckpoint(const FMapGridCheckpoint& Checkpoint);
+
+    // Save/load (C++)
+
+    /**
+     * Serialize the full map state (planes, palette by tag name, viewed bits, zones, rooms,
+     * passages, depths, occupant records) into a Zlib-compressed blob. Planes are run-length
+     * encoded before compression.
+     */
+    void SaveToBytes(TArray<uint8>& OutBytes) const;
+
+    /**
+     * Replace this map with a blob from SaveToBytes. Occupant actors are not spawned; their records
+     * are returned in OutActors. Derived state (blocked bits, zone index, free lists) is rebuilt.
+     * Returns false and leaves the map unchanged if the blob is invalid.
+     */
+    bool LoadFromBytes(const TArray<uint8>& InBytes, TArray<FMapCellActorRecord>& OutActors);
+
+    /** All occupant actors currently on the grid. */
+    void GetAllCellActors(TArray<ACellActor*>& OutActors) const;
+
     // Passages API (C++)
     const TArray<FZonePassage>& GetPassages() const { return Passages; }
     void SetPassages(const TArray<FZonePassage>& InPassages) { Passages = InPassages; }
@@ -154,16 +549,116 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="MapGrid")
 	int32 SizeY = 0;
 
-	/** Flat storage of cells: index = X + Y*SizeX */
+	// Column planes (runtime only, not reflected); all share the same size and storage mode
+
+    /** Background tag id per cell */
+    TMapGridPlane<uint16> BackgroundIds;
+
+    /** Object tag id per cell (0 = no object) */
+    TMapGridPlane<uint16> ObjectIds;
+
+    /** Object durability per cell (<=0 = no object) */
+    TMapGridPlane<int32> ObjectDurability;
+
+    /** Ore tag id per cell (0 = no ore) */
+    TMapGridPlane<uint16> OreIds;
+
+    /** Zone id per cell (-1 = unset) */
+    TMapGridPlane<int32> ZoneIds;
+
+    /** Viewed flag per cell, word-packed */
+    FMapGridBitPlane Viewed;
+
+    /** Walkability per cell (1 = blocked), word-packed; kept current by object and actor writes */
+    FMapGridBitPlane Blocked;
+
+    /** Change journal: one bit per cell for dedup plus indices in first-change order */
+    FMapGridBitPlane DirtyBits;
+    TArray<int32> DirtyCells;
+    bool bJournalEnabled = true;
+
+    /** Content version for snapshots; bumped by MarkDirty and by writes that bypass the journal.
+        Atomic because independent generation steps may write different planes concurrently. */
+    std::atomic<uint64> Epoch{0};
+
+    void BumpEpoch() { Epoch.fetch_add(1, std::memory_order_relaxed); }
+
+    /** See GetCellChangeCount; atomic for the same reason as Epoch */
+    std::atomic<uint64> CellChanges{0};
+
+    void CountCellChanges(uint64 Num) { CellChanges.fetch_add(Num, std::memory_order_relaxed); }
+
+    /** Last snapshot handed out, reused while Epoch matches. Weak so an unused snapshot does not force clones. */
+    mutable TWeakPtr<const FMapGridSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
+    // Zone index (CSR): cells of zone Z are ZoneCellIndices[ZoneCellStart[Z] .. ZoneCellStart[Z+1])
+    TArray<int32> ZoneCellStart;
+    TArray<int32> ZoneCellIndices;
+    TArray<FIntRect> ZoneBounds;
+    bool bZoneIndexValid = false;
+
+    /**
+     * Per-zone free cells (no object, no actor), kept current by object/actor/zone writes.
+     * Cells that stop being free are dropped lazily (see RefreshFreeCell), so a list may hold
+     * stale ids; FreeBits and ZoneNumFree are exact.
+     */
+    TArray<TArray<int32>> ZoneFreeCells;
+    TArray<int32> ZoneNumFree;
+
+    /** Cell is free / cell id is present in its zone's free list (two bits per cell instead of a slot plane) */
+    FMapGridBitPlane FreeBits;
+    FMapGridBitPlane FreeListed;
+
+    /** Disc row half-widths for the last radius passed to MarkDiscViewed */
+    TArray<int32> DiscHalfWidths;
+    int32 DiscHalfWidthsRadius = -1;
+
+    /** Sparse cell actor occupants: cell index -> actor. Most cells have none. */
     UPROPERTY()
-    TArray<FMapCell> Cells;
+    TMap<int32, TObjectPtr<ACellActor>> Occupants;
+
+    /** Palette: id -> tag. Index 0 is always the empty tag. */
+    TArray<FGameplayTag> Palette = { FGameplayTag() };
+
+    /** Palette reverse lookup: tag -> id */
+    TMap<FGameplayTag, uint16> PaletteLookup;
 
     // Stored passages between zones
     TArray<FZonePassage> Passages;
 
+    // Depth per zone id (see GetZoneDepth)
+    TArray<int32> ZoneDepths;
+
     // Stored generated rooms
     UPROPERTY(Transient)
     TArray<FRoomInfo> Rooms;
 
 	int32 Index(int32 X, int32 Y) const { return X + Y * SizeX; }
+
+    /** Single write path for object id + durability (keeps both empty together) */
+    void WriteObject(int32 X, int32 Y, uint16 ObjectId, int32 Durability);
+
+    /** Record a cell in the change journal (no-op if already recorded or journal disabled) */
+    void MarkDirty(int32 X, int32 Y)
+    {
+        BumpEpoch();
+        if (bJournalEnabled && !DirtyBits.Get(X, Y))
+        {
+            DirtyBits.Set(X, Y, true);
+            DirtyCells.Add(Index(X, Y));
+        }
+    }
+
+    /** Update a cell's free state after an object/actor/zone change */
+    void RefreshFreeCell(int32 X, int32 Y);
+
+    /** Take a cell out of its zone's free tracking before it moves to another zone */
+    void RemoveFromFreeList(int32 X, int32 Y);
+
+    /** Drop stale entries from a zone's free list */
+    void CompactFreeList(int32 InZoneId);
+
+    /** Rejection-sample a zone's free list; RandIndex maps a list size to an index */
+    template <typename RandFuncType>
+    bool PickFreeCell(int32 InZoneId, RandFuncType&& RandIndex, FIntPoint& OutCell) const;
 };
@@ -4,24 +4,79 @@
 #include "DigEmpire/BusEvents/MapGrid2DMessages.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Generation/MapGenerationStepDataBase.h"
+#include "Generation/MapGenerationPipeline.h"
+#include "Generation/MapGenerationCache.h"
 #include "DigEmpire/BusEvents/CharacterGridVisionMessages.h"
 #include "DigEmpire/Tags/DENativeTags.h"
+#include "CellActor.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#if WITH_EDITOR
+#include "UObject/UnrealType.h"
+#endif
+
+DECLARE_CYCLE_STAT(TEXT("Map build (game thread)"), STAT_MapGenBuild, STATGROUP_DigEmpireMapGen);
 
 UMapGrid2DComponent::UMapGrid2DComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Ticks only to flush the map change journal; late so the frame's digs are coalesced
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UMapGrid2DComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (GenerationPipeline)
+	{
+		PollAsyncGeneration();
+	}
+	FlushCellUpdates();
+}
+
+void UMapGrid2DComponent::FlushCellUpdates()
+{
+	if (!IsMapReady() || !MapInstance->HasPendingChanges()) return;
+
+	TArray<int32> Changed;
+	MapInstance->ConsumeChangedCells(Changed);
+
+	TArray<FGridCellWithCoord> Cells;
+	Cells.SetNum(Changed.Num());
+	for (int32 i = 0; i < Changed.Num(); ++i)
+	{
+		Cells[i].Coord = MapInstance->IndexToCell(Changed[i]);
+		MapInstance->GetCell(Cells[i].Coord.X, Cells[i].Coord.Y, Cells[i].Cell);
+	}
+	BroadcastCellsUpdated(Cells);
 }
 
 void UMapGrid2DComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+#if WITH_EDITOR
+	StepEditHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UMapGrid2DComponent::OnStepPropertyChanged);
+#endif
+
 	if (bInitializeOnBeginPlay)
 	{
 		InitializeAndBuild();
 	}
 }
 
+void UMapGrid2DComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelAsyncGeneration();
+	GenerationCheckpoints.Reset();
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(StepEditHandle);
+#endif
+	Super::EndPlay(EndPlayReason);
+}
+
 bool UMapGrid2DComponent::IsMapReady() const
 {
 	if (!MapInstance) return false;
@@ -49,6 +104,16 @@ bool UMapGrid2DComponent::GetObjectAt(int32 X, int32 Y, FGameplayTag& OutObjectT
     return IsMapReady() ? MapInstance->GetObjectAt(X, Y, OutObjectTag, OutDurability) : false;
 }
 
+bool UMapGrid2DComponent::HasObjectAt(int32 X, int32 Y) const
+{
+    return IsMapReady() ? MapInstance->HasObjectAt(X, Y) : false;
+}
+
+bool UMapGrid2DComponent::IsBlockedAt(int32 X, int32 Y) const
+{
+    return IsMapReady() ? MapInstance->IsBlockedAt(X, Y) : false;
+}
+
 bool UMapGrid2DComponent::SetActorAt(int32 X, int32 Y, ACellActor* InActor)
 {
     return IsMapReady() ? MapInstance->SetActorAt(X, Y, InActor) : false;
@@ -99,18 +164,34 @@ bool UMapGrid2DComponent::DamageObjectAt(int32 X, int32 Y, int32 Damage, bool& b
         MapInstance->AddOrUpdateObjectAt(X, Y, Obj, NewDur);
     }
 
-    // Prepare and broadcast update
-    FGridCellWithCoord Entry;
-    Entry.Coord = FIntPoint(X, Y);
-    MapInstance->GetCell(X, Y, Entry.Cell);
-    TArray<FGridCellWithCoord> Cells;
-    Cells.Add(Entry);
-    BroadcastCellsUpdated(Cells);
+    // The change journal picks this cell up; FlushCellUpdates broadcasts it with the rest of the frame's changes
     return true;
 }
 
 void UMapGrid2DComponent::InitializeAndBuild()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMapGrid2DComponent::InitializeAndBuild);
+	SCOPE_CYCLE_COUNTER(STAT_MapGenBuild);
+
+	// A build still running would finish into a map we are about to replace
+	CancelAsyncGeneration();
+
+	LastGenerationReport = FMapGenReport();
+	GenerationStartTime = FPlatformTime::Seconds();
+
+	PendingCacheKey.Reset();
+	GenerationCheckpoints.Reset();
+	if (bAutoGenerate && bUseGenerationCache && TryLoadFromGenerationCache())
+	{
+		return;
+	}
+
+	if (bGenerateAsync && bAutoGenerate)
+	{
+		StartAsyncGeneration();
+		return;
+	}
+
 	// Create the map instance if missing.
 	if (!MapInstance)
 	{
@@ -120,41 +201,406 @@ void UMapGrid2DComponent::InitializeAndBuild()
 	// Initialize size.
 	const int32 SafeSizeX = FMath::Max(1, MapSizeX);
 	const int32 SafeSizeY = FMath::Max(1, MapSizeY);
-	MapInstance->Initialize(SafeSizeX, SafeSizeY);
+	MapInstance->Initialize(SafeSizeX, SafeSizeY, bUseChunkedStorage);
+
+    // MapReady makes listeners rebuild everything, so a full build does not need per-cell journaling
+    MapInstance->SetChangeJournalEnabled(false);
 
     // Fill and build borders.
     FillBackground();
 
     // Execute configured generation steps automatically if enabled
-    ZoneLabelsCache.Reset();
+    GenerationContext.Bind(MapInstance, GetWorld());
+    GenerationContext.ResetZoneLabels();
     CurrentGenerationStep = 0;
     if (bAutoGenerate)
     {
-        for (const UMapGenerationStepDataBase* Step : GenerationSteps)
+        RunGenerationSteps(0);
+    }
+
+    // Release chunk tiles that generation left uniform (no-op for flat storage)
+    MapInstance->CompactStorage();
+    MapInstance->SetChangeJournalEnabled(true);
+    if (bAutoGenerate)
+    {
+        PublishGenerationReport();
+        StoreInGenerationCache();
+    }
+    ReleaseGenerationScratch();
+
+    // Notify via Event Bus.
+    BroadcastMapReady();
+}
+
+void UMapGrid2DComponent::RunGenerationSteps(int32 FirstStep)
+{
+    // Checkpoints are only consistent up to the first actor placer (placed actors are not captured)
+    bool bCheckpoints = bKeepGenerationCheckpoints;
+    for (int32 i = 0; i < FirstStep && bCheckpoints; ++i)
+    {
+        bCheckpoints = !(GenerationSteps[i] && GenerationSteps[i]->RequiresGameThread());
+    }
+    if (bCheckpoints)
+    {
+        GenerationCheckpoints.SetNum(GenerationSteps.Num());
+    }
+
+    for (int32 i = FirstStep; i < GenerationSteps.Num(); ++i)
+    {
+        const UMapGenerationStepDataBase* Step = GenerationSteps[i];
+        if (!Step) continue;
+
+        if (bCheckpoints)
         {
-            if (Step)
-            {
-                Step->ExecuteGenerationStep(MapInstance, GetWorld(), ZoneLabelsCache);
-                ++CurrentGenerationStep;
-            }
+            FGenerationCheckpoint& CP = GenerationCheckpoints[i];
+            MapInstance->CreateCheckpoint(CP.Map);
+
+            CP.ZoneLabels = GenerationContext.ShareZoneLabels();
+
+            bCheckpoints = !Step->RequiresGameThread();
         }
+
+        MapGenReport::ExecuteStep(Step, GenerationContext, LastGenerationReport.Steps.AddDefaulted_GetRef());
     }
+    CurrentGenerationStep = GenerationSteps.Num();
+}
 
-    // Notify via Event Bus.
+void UMapGrid2DComponent::RegenerateFromStep(int32 StepIndex)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMapGrid2DComponent::RegenerateFromStep);
+    SCOPE_CYCLE_COUNTER(STAT_MapGenBuild);
+
+    // Closest checkpoint at or before the step
+    int32 From = FMath::Min(StepIndex, GenerationCheckpoints.Num() - 1);
+    while (From >= 0 && !GenerationCheckpoints[From].Map.IsValid())
+    {
+        --From;
+    }
+
+    const bool bUsable = From >= 0 && IsMapReady() && !IsGenerating()
+        && GenerationCheckpoints[From].Map.Cells->GetSize() == FIntPoint(FMath::Max(1, MapSizeX), FMath::Max(1, MapSizeY))
+        && GenerationCheckpoints[From].Map.bChunked == bUseChunkedStorage;
+    if (!bUsable)
+    {
+        InitializeAndBuild();
+        return;
+    }
+
+    LastGenerationReport = FMapGenReport();
+    GenerationStartTime = FPlatformTime::Seconds();
+
+    // Actors placed by the steps being rerun are placed again
+    TArray<ACellActor*> OldActors;
+    MapInstance->GetAllCellActors(OldActors);
+    for (ACellActor* Actor : OldActors)
+    {
+        if (IsValid(Actor)) Actor->Destroy();
+    }
+
+    const FGenerationCheckpoint& CP = GenerationCheckpoints[From];
+    MapInstance->SetChangeJournalEnabled(false);
+    MapInstance->RestoreCheckpoint(CP.Map);
+    GenerationContext.Bind(MapInstance, GetWorld());
+    if (CP.ZoneLabels) GenerationContext.SetZoneLabels(CP.ZoneLabels.ToSharedRef());
+    else GenerationContext.ResetZoneLabels();
+    GenerationCheckpoints.SetNum(From + 1); // later ones are retaken by the rerun
+    RunGenerationSteps(From);
+    SetZoneDepths(MapInstance->GetZoneDepths());
+
+    MapInstance->CompactStorage();
+    MapInstance->SetChangeJournalEnabled(true);
+    PublishGenerationReport();
+
+    PendingCacheKey.Reset();
+    if (bUseGenerationCache)
+    {
+        MapGenCache::ComputeKey(MapInstance->GetSize(), bUseChunkedStorage, DefaultBackgroundTag, GetConfiguredSteps(), PendingCacheKey);
+        StoreInGenerationCache();
+    }
+    ReleaseGenerationScratch();
     BroadcastMapReady();
 }
 
+#if WITH_EDITOR
+void UMapGrid2DComponent::OnStepPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Slider drags fire interactive changes every frame; regenerate once the value is committed
+    if (!bKeepGenerationCheckpoints || Event.ChangeType == EPropertyChangeType::Interactive) return;
+
+    for (int32 i = 0; i < GenerationSteps.Num(); ++i)
+    {
+        if (GenerationSteps[i] == Object)
+        {
+            RegenerateFromStep(i);
+            return;
+        }
+    }
+}
+#endif
+
+bool UMapGrid2DComponent::SaveMapToBytes(TArray<uint8>& OutBytes) const
+{
+    if (!IsMapReady()) return false;
+    MapInstance->SaveToBytes(OutBytes);
+    return OutBytes.Num() > 0;
+}
+
+bool UMapGrid2DComponent::LoadMapFromBytes(const TArray<uint8>& InBytes)
+{
+    UWorld* World = GetWorld();
+    if (!World) return false;
+    CancelAsyncGeneration();
+    if (!MapInstance)
+    {
+        MapInstance = NewObject<UMapGrid2D>(this);
+    }
+
+    // Keep the old actors until the blob is known to be valid
+    TArray<ACellActor*> OldActors;
+    MapInstance->GetAllCellActors(OldActors);
+
+    MapInstance->SetChangeJournalEnabled(false);
+    TArray<FMapCellActorRecord> Records;
+    if (!MapInstance->LoadFromBytes(InBytes, Records))
+    {
+        MapInstance->SetChangeJournalEnabled(true);
+        return false;
+    }
+
+    for (ACellActor* Actor : OldActors)
+    {
+        if (IsValid(Actor)) Actor->Destroy();
+    }
+
+    for (const FMapCellActorRecord& Rec : Records)
+    {
+        UClass* ActorClass = FSoftClassPath(Rec.ClassPath).TryLoadClass<ACellActor>();
+        if (!ActorClass) continue;
+
+        FActorSpawnParameters Params;
+        Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        ACellActor* Actor = World->SpawnActor<ACellActor>(ActorClass, Rec.Location, FRotator::ZeroRotator, Params);
+        if (!Actor) continue;
+
+        // Place first so state changes that affect blocking (e.g. an open door) reach the grid
+        MapInstance->SetActorAt(Rec.Cell.X, Rec.Cell.Y, Actor);
+        FMemoryReader StateAr(Rec.State);
+        Actor->SerializeCellState(StateAr);
+    }
+
+    // A loaded map is complete: no generation steps are pending
+    GenerationContext.ResetZoneLabels();
+    GenerationCheckpoints.Reset();
+    CurrentGenerationStep = GenerationSteps.Num();
+    SetZoneDepths(MapInstance->GetZoneDepths());
+
+    MapInstance->CompactStorage();
+    MapInstance->SetChangeJournalEnabled(true);
+    BroadcastMapReady();
+    return true;
+}
+
+bool UMapGrid2DComponent::SaveMapToFile(const FString& FilePath) const
+{
+    TArray<uint8> Bytes;
+    return SaveMapToBytes(Bytes) && FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool UMapGrid2DComponent::LoadMapFromFile(const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    return FFileHelper::LoadFileToArray(Bytes, *FilePath) && LoadMapFromBytes(Bytes);
+}
+
+void UMapGrid2DComponent::StartAsyncGeneration()
+{
+    // Steps run against a private map so the live one (if any) stays consistent meanwhile
+    PendingMap = NewObject<UMapGrid2D>(GetTransientPackage());
+    PendingMap->Initialize(FMath::Max(1, MapSizeX), FMath::Max(1, MapSizeY), bUseChunkedStorage);
+    PendingMap->SetChangeJournalEnabled(false);
+    PendingMap->FillBackground(DefaultBackgroundTag);
+
+    const TArray<const UMapGenerationStepDataBase*> Steps = GetConfiguredSteps();
+    GenerationPipeline = MakeShared<FMapGenerationPipeline>(PendingMap, Steps);
+    LastReportedStep = 0;
+    BroadcastGenerationProgress(0, Steps.Num(), FString());
+    GenerationPipeline->Launch();
+}
+
+void UMapGrid2DComponent::PollAsyncGeneration()
+{
+    const int32 Done = GenerationPipeline->GetStepsDone();
+    if (Done != LastReportedStep)
+    {
+        LastReportedStep = Done;
+        const int32 LastStep = GenerationPipeline->GetLastFinishedStep();
+        BroadcastGenerationProgress(Done, GenerationPipeline->GetNumSteps(),
+            LastStep != INDEX_NONE ? GenerationPipeline->GetStep(LastStep)->GetName() : FString());
+    }
+
+    if (GenerationPipeline->IsWorkerPhaseDone())
+    {
+        FinishAsyncGeneration();
+    }
+}
+
+void UMapGrid2DComponent::FinishAsyncGeneration()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMapGrid2DComponent::FinishAsyncGeneration);
+    SCOPE_CYCLE_COUNTER(STAT_MapGenBuild);
+    const TSharedPtr<FMapGenerationPipeline> Pipeline = MoveTemp(GenerationPipeline);
+
+    for (const FMapGenStepReport& StepReport : Pipeline->GetStepReports())
+    {
+        if (!StepReport.StepName.IsEmpty()) LastGenerationReport.Steps.Add(StepReport);
+    }
+
+    // Adopt the private map
+    PendingMap->Rename(nullptr, this, REN_DontCreateRedirectors | REN_NonTransactional);
+    MapInstance = PendingMap;
+    PendingMap = nullptr;
+    GenerationContext.Bind(MapInstance, GetWorld());
+    GenerationContext.SetZoneLabels(Pipeline->GetContext().ShareZoneLabels());
+
+    // Actor placers (and anything configured after them) need the world
+    for (int32 i = Pipeline->GetNumWorkerSteps(); i < Pipeline->GetNumSteps(); ++i)
+    {
+        const UMapGenerationStepDataBase* Step = Pipeline->GetStep(i);
+        MapGenReport::ExecuteStep(Step, GenerationContext, LastGenerationReport.Steps.AddDefaulted_GetRef());
+        BroadcastGenerationProgress(i + 1, Pipeline->GetNumSteps(), Step->GetName());
+    }
+    CurrentGenerationStep = GenerationSteps.Num();
+    SetZoneDepths(MapInstance->GetZoneDepths());
+
+    MapInstance->CompactStorage();
+    MapInstance->SetChangeJournalEnabled(true);
+    PublishGenerationReport();
+    StoreInGenerationCache();
+    ReleaseGenerationScratch();
+    BroadcastMapReady();
+}
+
+void UMapGrid2DComponent::ReleaseGenerationScratch()
+{
+    // Border and passage buffers alone are ~10 bytes per cell; only worth keeping for quick reruns
+    if (!bKeepGenerationCheckpoints)
+    {
+        GenerationContext.GetScratch().Trim();
+    }
+}
+
+void UMapGrid2DComponent::CancelAsyncGeneration()
+{
+    if (!GenerationPipeline) return;
+    GenerationPipeline->Cancel();
+    GenerationPipeline.Reset(); // waits for the step in flight
+    PendingMap = nullptr;
+}
+
+void UMapGrid2DComponent::PublishGenerationReport()
+{
+    LastGenerationReport.MapSize = MapInstance ? MapInstance->GetSize() : FIntPoint::ZeroValue;
+    LastGenerationReport.TotalSeconds = FPlatformTime::Seconds() - GenerationStartTime;
+
+    if (bLogGenerationReport)
+    {
+        LastGenerationReport.Log();
+    }
+    if (!GenerationReportCsvPath.IsEmpty())
+    {
+        const FString CsvPath = FPaths::IsRelative(GenerationReportCsvPath)
+            ? FPaths::Combine(FPaths::ProjectSavedDir(), GenerationReportCsvPath)
+            : GenerationReportCsvPath;
+        if (!LastGenerationReport.AppendToCsv(CsvPath))
+        {
+            UE_LOG(LogDigEmpireMapGen, Warning, TEXT("Could not write generation report to %s"), *CsvPath);
+        }
+    }
+}
+
+TArray<const UMapGenerationStepDataBase*> UMapGrid2DComponent::GetConfiguredSteps() const
+{
+    TArray<const UMapGenerationStepDataBase*> Steps;
+    for (const UMapGenerationStepDataBase* Step : GenerationSteps)
+    {
+        if (Step) Steps.Add(Step);
+    }
+    return Steps;
+}
+
+bool UMapGrid2DComponent::TryLoadFromGenerationCache()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UMapGrid2DComponent::TryLoadFromGenerationCache);
+
+    // Cached cell actors are respawned, which needs the world
+    if (!GetWorld()) return false;
+
+    FString Key;
+    const FIntPoint Size(FMath::Max(1, MapSizeX), FMath::Max(1, MapSizeY));
+    if (!MapGenCache::ComputeKey(Size, bUseChunkedStorage, DefaultBackgroundTag, GetConfiguredSteps(), Key))
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    if (!MapGenCache::Load(Key, Bytes))
+    {
+        PendingCacheKey = Key;
+        return false;
+    }
+    if (!LoadMapFromBytes(Bytes))
+    {
+        // Written by an incompatible build or damaged: regenerate and replace it
+        UE_LOG(LogDigEmpireMapGen, Warning, TEXT("Discarding unreadable map cache entry %s"), *MapGenCache::GetEntryPath(Key));
+        MapGenCache::Remove(Key);
+        PendingCacheKey = Key;
+        return false;
+    }
+
+    LastGenerationReport.MapSize = MapInstance->GetSize();
+    LastGenerationReport.TotalSeconds = FPlatformTime::Seconds() - GenerationStartTime;
+    if (bLogGenerationReport)
+    {
+        UE_LOG(LogDigEmpireMapGen, Log, TEXT("Map %dx%d loaded from cache %s in %.2f ms"),
+            LastGenerationReport.MapSize.X, LastGenerationReport.MapSize.Y, *Key, LastGenerationReport.TotalSeconds * 1000.0);
+    }
+    return true;
+}
+
+void UMapGrid2DComponent::StoreInGenerationCache()
+{
+    if (PendingCacheKey.IsEmpty() || !IsMapReady()) return;
+    MapGenCache::Store(PendingCacheKey, MapInstance);
+    PendingCacheKey.Reset();
+}
+
+void UMapGrid2DComponent::BroadcastGenerationProgress(int32 StepsDone, int32 NumSteps, const FString& LastStepName)
+{
+    if (!GetWorld()) return;
+
+    FMapGenerationProgressMessage Msg;
+    Msg.Source = this;
+    Msg.StepsDone = StepsDone;
+    Msg.NumSteps = NumSteps;
+    Msg.LastStepName = LastStepName;
+
+    UGameplayMessageSubsystem& Bus = UGameplayMessageSubsystem::Get(this);
+    Bus.BroadcastMessage(TAG_Map_GenerationProgress, Msg);
+}
+
 void UMapGrid2DComponent::ExecuteNextGenerationStep()
 {
+    if (IsGenerating()) return;
+
     // Ensure map exists and initialized (without running steps)
     if (!MapInstance)
     {
         MapInstance = NewObject<UMapGrid2D>(this);
         const int32 SafeSizeX = FMath::Max(1, MapSizeX);
         const int32 SafeSizeY = FMath::Max(1, MapSizeY);
-        MapInstance->Initialize(SafeSizeX, SafeSizeY);
+        MapInstance->Initialize(SafeSizeX, SafeSizeY, bUseChunkedStorage);
         FillBackground();
-        ZoneLabelsCache.Reset();
+        GenerationContext.ResetZoneLabels();
         CurrentGenerationStep = 0;
     }
 
@@ -163,10 +609,18 @@ void UMapGrid2DComponent::ExecuteNextGenerationStep()
     {
         if (const UMapGenerationStepDataBase* Step = GenerationSteps[CurrentGenerationStep])
         {
-            Step->ExecuteGenerationStep(MapInstance, GetWorld(), ZoneLabelsCache);
+            FMapGenStepReport StepReport;
+            GenerationContext.Bind(MapInstance, GetWorld());
+            MapGenReport::ExecuteStep(Step, GenerationContext, StepReport);
+            UE_LOG(LogDigEmpireMapGen, Verbose, TEXT("Step %s: %.2f ms, %llu cells"),
+                *StepReport.StepName, StepReport.WallSeconds * 1000.0, StepReport.CellsMutated);
+            ReleaseGenerationScratch();
         }
         ++CurrentGenerationStep;
     }
+
+    // Listeners get this step's mutations (and the initial fill) as one incremental update
+    FlushCellUpdates();
 }
 
 
@@ -174,14 +628,7 @@ void UMapGrid2DComponent::ExecuteNextGenerationStep()
 {
 	if (!IsMapReady()) return;
 
-	const FIntPoint Size = MapInstance->GetSize();
-	for (int32 Y = 0; Y < Size.Y; ++Y)
-	{
-		for (int32 X = 0; X < Size.X; ++X)
-		{
-			MapInstance->SetBackgroundAt(X, Y, DefaultBackgroundTag);
-		}
-	}
+	MapInstance->FillBackground(DefaultBackgroundTag);
 }
 
 void UMapGrid2DComponent::BroadcastMapReady()
@@ -200,6 +647,11 @@ void UMapGrid2DComponent::BroadcastMapReady()
 	Bus.BroadcastMessage(MapReadyChannel, Message);
 }
 
+int32 UMapGrid2DComponent::GetZoneDepth(int32 ZoneId) const
+{
+    return MapInstance ? MapInstance->GetZoneDepth(ZoneId) : -1;
+}
+
 void UMapGrid2DComponent::SetZoneDepths(const TArray<int32>& Depths)
 {
     ZoneInfos.SetNum(Depths.Num());
@@ -4,11 +4,15 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GameplayTagContainer.h"
+#include "Generation/MapGenerationReport.h"
+#include "Generation/MapGenerationContext.h"
+#include "MapGrid2D.h" // FMapGridCheckpoint
 #include "MapGrid2DComponent.generated.h"
 
 class UMapGrid2D;
 class ACellActor;
 class UMapGenerationStepDataBase;
+class FMapGenerationPipeline;
 
 USTRUCT(BlueprintType)
 struct FZoneInfo
@@ -48,10 +52,50 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
     bool bAutoGenerate = true;
 
+    /**
+     * If true, InitializeAndBuild returns immediately and the steps run on worker threads against
+     * a private map; steps whose declared plane access does not conflict run concurrently.
+     * Steps that RequiresGameThread (actor placers) and all steps after them run on
+     * the game thread at the end. Progress is published on Gameplay.Map.GenerationProgress and
+     * MapReadyChannel fires when done.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
+    bool bGenerateAsync = false;
+
+    /** If true, every build logs its per-step report to LogDigEmpireMapGen. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
+    bool bLogGenerationReport = true;
+
+    /** If set, every build appends its per-step report to this CSV file (relative paths are under Saved/). */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
+    FString GenerationReportCsvPath;
+
+    /**
+     * Opt-in. If true and every step has a fixed RandomSeed, finished maps are stored under Saved/MapCache
+     * keyed by a hash of the size, step settings and game binary, and later builds with the same key
+     * load the stored map (cell actors are respawned from it) instead of running the steps.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
+    bool bUseGenerationCache = false;
+
+    /**
+     * If true, synchronous builds keep a checkpoint of the map and zone labels before each step
+     * (planes are shared copy-on-write, so each costs only what later steps write) and
+     * RegenerateFromStep resumes from them. In the editor, changing a step asset's properties
+     * while playing regenerates from that step. Checkpoints stop at the first step that
+     * RequiresGameThread, since placed actors are not captured.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Generation")
+    bool bKeepGenerationCheckpoints = false;
+
 	/** Map height (in cells). */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Init", meta=(ClampMin="1"))
 	int32 MapSizeY = 64;
 
+	/** Store the map in lazily allocated chunks instead of flat planes. Use for very large maps (e.g. 4096x4096). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Init")
+	bool bUseChunkedStorage = false;
+
 	/** Default background tag for all cells. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MapGrid|Init")
 	FGameplayTag DefaultBackgroundTag;
@@ -89,6 +133,12 @@ public:
     UFUNCTION(BlueprintPure, Category="MapGrid|Access")
     bool GetObjectAt(int32 X, int32 Y, FGameplayTag& OutObjectTag, int32& OutDurability) const;
 
+    UFUNCTION(BlueprintPure, Category="MapGrid|Access")
+    bool HasObjectAt(int32 X, int32 Y) const;
+
+    UFUNCTION(BlueprintPure, Category="MapGrid|Access")
+    bool IsBlockedAt(int32 X, int32 Y) const;
+
     UFUNCTION(BlueprintCallable, Category="MapGrid|Access")
     bool SetActorAt(int32 X, int32 Y, ACellActor* InActor);
 
@@ -113,25 +163,57 @@ public:
     UFUNCTION(BlueprintCallable, Category="MapGrid|Init")
     void InitializeAndBuild();
 
+    /**
+     * Rerun the steps from StepIndex on, starting from the checkpoint taken before it (or the
+     * closest earlier one). Falls back to InitializeAndBuild without a usable checkpoint.
+     */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Generation")
+    void RegenerateFromStep(int32 StepIndex);
+
+    /** Per-step timing/memory report of the last completed build. */
+    const FMapGenReport& GetLastGenerationReport() const { return LastGenerationReport; }
+
+    /** True while an async build (bGenerateAsync) is running. */
+    UFUNCTION(BlueprintPure, Category="MapGrid|Generation")
+    bool IsGenerating() const { return GenerationPipeline.IsValid(); }
+
     /** Execute the next configured generation step (does nothing if none left). */
     UFUNCTION(BlueprintCallable, Category="MapGrid|Generation")
     void ExecuteNextGenerationStep();
 
+    /** Broadcast every cell changed since the last flush as one cells-updated message. Runs automatically once per frame. */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Events")
+    void FlushCellUpdates();
+
+    /** Save the full map state (cells, zones, rooms, cell actors) to a compressed file. */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Save")
+    bool SaveMapToFile(const FString& FilePath) const;
+
+    /** Replace the current map with a file written by SaveMapToFile and broadcast MapReady. */
+    UFUNCTION(BlueprintCallable, Category="MapGrid|Save")
+    bool LoadMapFromFile(const FString& FilePath);
+
+    bool SaveMapToBytes(TArray<uint8>& OutBytes) const;
+    bool LoadMapFromBytes(const TArray<uint8>& InBytes);
+
 	/** Returns the underlying map object (can be null). */
     UFUNCTION(BlueprintPure, Category="MapGrid|Access")
     UMapGrid2D* GetMap() const { return MapInstance; }
 
-    /** Per-zone computed info (e.g., depth from Zone 0). Index = ZoneId. */
+    /** Per-zone computed info (e.g., depth from Zone 0). Index = ZoneId. Mirrors the depths stored on the map. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="MapGrid|Zones")
     TArray<FZoneInfo> ZoneInfos;
 
     UFUNCTION(BlueprintPure, Category="MapGrid|Zones")
-    int32 GetZoneDepth(int32 ZoneId) const { return ZoneInfos.IsValidIndex(ZoneId) ? ZoneInfos[ZoneId].Depth : -1; }
+    int32 GetZoneDepth(int32 ZoneId) const;
 
     void SetZoneDepths(const TArray<int32>& Depths);
 
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	/** Owned map object. */
@@ -142,9 +224,64 @@ private:
     UPROPERTY(Transient)
     int32 CurrentGenerationStep = 0;
 
-    /** Cached zone labels passed through generation steps across calls. */
+    /** Zone labels and scratch arena passed through the synchronous steps (see ReleaseGenerationScratch). */
+    FMapGenerationContext GenerationContext;
+
+    /** Map being built by the async pipeline; becomes MapInstance when the worker steps finish. */
     UPROPERTY(Transient)
-    TArray<int32> ZoneLabelsCache;
+    TObjectPtr<UMapGrid2D> PendingMap = nullptr;
+
+    /** Running async build (null when idle). */
+    TSharedPtr<FMapGenerationPipeline> GenerationPipeline;
+
+    /** Last worker step count published as progress. */
+    int32 LastReportedStep = -1;
+
+    /** Report of the last build and the start time of the build in progress */
+    FMapGenReport LastGenerationReport;
+    double GenerationStartTime = 0.0;
+
+    /** Close the report of the build that just finished, log it and append it to the CSV. */
+    void PublishGenerationReport();
+
+    /** Cache key of the build in progress (empty = not cacheable or already stored) */
+    FString PendingCacheKey;
+
+    /** Non-null steps in list order. */
+    TArray<const UMapGenerationStepDataBase*> GetConfiguredSteps() const;
+
+    /** Load the map for the current settings from the generation cache; sets PendingCacheKey on a miss. */
+    bool TryLoadFromGenerationCache();
+
+    /** Store the map of the build that just finished under PendingCacheKey. */
+    void StoreInGenerationCache();
+
+    /** Free the scratch arena after a build unless checkpoints are kept, where reruns reuse it. */
+    void ReleaseGenerationScratch();
+
+    /** State before one generation step (see bKeepGenerationCheckpoints) */
+    struct FGenerationCheckpoint
+    {
+        FMapGridCheckpoint Map;
+        TSharedPtr<const TArray<int32>, ESPMode::ThreadSafe> ZoneLabels; // shared with the context until a step replaces them
+    };
+
+    /** Index = GenerationSteps index; invalid entries have no checkpoint */
+    TArray<FGenerationCheckpoint> GenerationCheckpoints;
+
+    /** Run GenerationSteps[FirstStep..] on MapInstance synchronously, recording checkpoints. */
+    void RunGenerationSteps(int32 FirstStep);
+
+#if WITH_EDITOR
+    FDelegateHandle StepEditHandle;
+    void OnStepPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+#endif
+
+    void StartAsyncGeneration();
+    void PollAsyncGeneration();
+    void FinishAsyncGeneration();
+    void CancelAsyncGeneration();
+    void BroadcastGenerationProgress(int32 StepsDone, int32 NumSteps, const FString& LastStepName);
 
     void FillBackground();
     void BroadcastMapReady();  // <-- Event Bus publisher
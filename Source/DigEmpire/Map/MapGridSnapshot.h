@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "MapGridStorage.h"
+
+/**
+ * Immutable view of a UMapGrid2D at one point in time (see UMapGrid2D::CreateSnapshot).
+ *
+ * Safe to read from any thread while the game thread keeps writing the grid: the planes
+ * share storage with the grid and the grid clones what it writes (copy-on-write).
+ * Occupant actors are not included; use IsBlockedAt for walkability.
+ */
+class FMapGridSnapshot
+{
+public:
+    /** Grid epoch this snapshot was taken at; equal epochs mean identical content. */
+    uint64 GetEpoch() const { return Epoch; }
+
+    FIntPoint GetSize() const { return FIntPoint(SizeX, SizeY); }
+
+    bool IsInBounds(int32 X, int32 Y) const
+    {
+        return X >= 0 && Y >= 0 && X < SizeX && Y < SizeY;
+    }
+
+    /** Same rule as UMapGrid2D::IsBlockedAt (false if out of bounds). */
+    bool IsBlockedAt(int32 X, int32 Y) const { return IsInBounds(X, Y) && Blocked.Get(X, Y); }
+
+    bool HasObjectAt(int32 X, int32 Y) const { return IsInBounds(X, Y) && ObjectDurability.Get(X, Y) > 0; }
+    bool IsViewedAt(int32 X, int32 Y) const { return IsInBounds(X, Y) && Viewed.Get(X, Y); }
+
+    // Palette ids (0 = empty / out of bounds); resolve with GetTagById
+    uint16 GetBackgroundIdAt(int32 X, int32 Y) const { return IsInBounds(X, Y) ? BackgroundIds.Get(X, Y) : 0; }
+    uint16 GetObjectIdAt(int32 X, int32 Y) const { return IsInBounds(X, Y) ? ObjectIds.Get(X, Y) : 0; }
+    uint16 GetOreIdAt(int32 X, int32 Y) const { return IsInBounds(X, Y) ? OreIds.Get(X, Y) : 0; }
+
+    int32 GetDurabilityAt(int32 X, int32 Y) const { return IsInBounds(X, Y) ? ObjectDurability.Get(X, Y) : 0; }
+    int32 GetZoneAt(int32 X, int32 Y) const { return IsInBounds(X, Y) ? ZoneIds.Get(X, Y) : -1; }
+    int32 GetZoneDepth(int32 ZoneId) const { return ZoneDepths.IsValidIndex(ZoneId) ? ZoneDepths[ZoneId] : -1; }
+
+    const FGameplayTag& GetTagById(uint16 Id) const
+    {
+        return Palette.IsValidIndex(Id) ? Palette[Id] : Palette[0];
+    }
+
+    // Whole planes for bulk scans (index = X + Y*SizeX)
+    const TMapGridPlane<uint16>& GetBackgroundPlane() const { return BackgroundIds; }
+    const TMapGridPlane<uint16>& GetObjectIdPlane() const { return ObjectIds; }
+    const TMapGridPlane<int32>& GetDurabilityPlane() const { return ObjectDurability; }
+    const TMapGridPlane<uint16>& GetOrePlane() const { return OreIds; }
+    const TMapGridPlane<int32>& GetZonePlane() const { return ZoneIds; }
+    const FMapGridBitPlane& GetViewedPlane() const { return Viewed; }
+    const FMapGridBitPlane& GetBlockedPlane() const { return Blocked; }
+
+private:
+    friend class UMapGrid2D;
+
+    uint64 Epoch = 0;
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+
+    TMapGridPlane<uint16> BackgroundIds;
+    TMapGridPlane<uint16> ObjectIds;
+    TMapGridPlane<int32> ObjectDurability;
+    TMapGridPlane<uint16> OreIds;
+    TMapGridPlane<int32> ZoneIds;
+    FMapGridBitPlane Viewed;
+    FMapGridBitPlane Blocked;
+
+    TArray<FGameplayTag> Palette = { FGameplayTag() };
+    TArray<int32> ZoneDepths;
+};
+
+using FMapGridSnapshotRef = TSharedRef<const FMapGridSnapshot, ESPMode::ThreadSafe>;
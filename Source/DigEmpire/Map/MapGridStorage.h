@@ -0,0 +1,420 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One per-cell field of a UMapGrid2D (a "plane").
+ *
+ * Flat mode: a single SizeX*SizeY array, index = X + Y*SizeX.
+ * Chunked mode: the map is split into ChunkSize x ChunkSize tiles. A tile holds a single
+ * uniform value until a differing value is written into it, then it is materialized.
+ * Compact() collapses materialized tiles that became uniform again.
+ *
+ * Copies are cheap: cell storage (the flat array, or each materialized tile) is reference
+ * counted and shared between copies, and a plane clones a shared array on its first write
+ * to it (copy-on-write). A copy can therefore be read on another thread while the original
+ * keeps being written. Flat planes clone the whole array; chunked planes clone one tile.
+ */
+template<typename T>
+class TMapGridPlane
+{
+public:
+    static constexpr int32 ChunkShift = 5;
+    static constexpr int32 ChunkSize = 1 << ChunkShift;
+    static constexpr int32 ChunkMask = ChunkSize - 1;
+    static constexpr int32 ChunkCells = ChunkSize * ChunkSize;
+
+    using FCells = TArray<T>;
+    using FCellsRef = TSharedPtr<FCells, ESPMode::ThreadSafe>;
+
+    /** Resize and fill with Value. Chunked planes start with every tile uniform. */
+    void Init(int32 InSizeX, int32 InSizeY, const T& Value, bool bInChunked)
+    {
+        SizeX = FMath::Max(0, InSizeX);
+        SizeY = FMath::Max(0, InSizeY);
+        bChunked = bInChunked;
+        NumChunksX = (SizeX + ChunkMask) >> ChunkShift;
+        NumChunksY = (SizeY + ChunkMask) >> ChunkShift;
+
+        if (bChunked)
+        {
+            Data.Reset();
+            FlatData = nullptr;
+            Chunks.Reset();
+            Chunks.SetNum(NumChunksX * NumChunksY);
+        }
+        else
+        {
+            Chunks.Empty();
+        }
+        Fill(Value);
+    }
+
+    /** Set every cell to Value (chunked: every tile becomes uniform and releases its cells). */
+    void Fill(const T& Value)
+    {
+        if (bChunked)
+        {
+            for (FChunk& C : Chunks)
+            {
+                C.Uniform = Value;
+                C.Cells.Reset();
+            }
+        }
+        else
+        {
+            FCells& Cells = Detach(Data, /*bKeepContents*/ false);
+            Cells.Init(Value, SizeX * SizeY);
+            FlatData = Cells.GetData();
+        }
+    }
+
+    /** Copy a flat SizeX*SizeY array in. Chunked planes keep tiles uniform where the source is. */
+    void Assign(const T* Src)
+    {
+        if (!bChunked)
+        {
+            FCells& Cells = Detach(Data, /*bKeepContents*/ false);
+            Cells.SetNumUninitialized(SizeX * SizeY);
+            FMemory::Memcpy(Cells.GetData(), Src, sizeof(T) * SizeX * SizeY);
+            FlatData = Cells.GetData();
+            return;
+        }
+        for (int32 cy = 0; cy < NumChunksY; ++cy)
+        for (int32 cx = 0; cx < NumChunksX; ++cx)
+        {
+            const FIntRect R = GetChunkRect(cx, cy);
+            FChunk& C = Chunks[cx + cy * NumChunksX];
+            const T First = Src[R.Min.X + R.Min.Y * SizeX];
+            bool bUniform = true;
+            for (int32 y = R.Min.Y; y < R.Max.Y && bUniform; ++y)
+            for (int32 x = R.Min.X; x < R.Max.X; ++x)
+            {
+                if (!(Src[x + y * SizeX] == First)) { bUniform = false; break; }
+            }
+            C.Uniform = First;
+            if (bUniform)
+            {
+                C.Cells.Reset();
+                continue;
+            }
+            FCells& Cells = Detach(C.Cells, /*bKeepContents*/ false);
+            Cells.SetNumUninitialized(ChunkCells);
+            for (int32 y = R.Min.Y; y < R.Max.Y; ++y)
+            {
+                FMemory::Memcpy(&Cells[((y & ChunkMask) << ChunkShift)], &Src[R.Min.X + y * SizeX], sizeof(T) * R.Width());
+            }
+        }
+    }
+
+    T Get(int32 X, int32 Y) const
+    {
+        if (!bChunked) return FlatData[X + Y * SizeX];
+        const FChunk& C = Chunks[(X >> ChunkShift) + (Y >> ChunkShift) * NumChunksX];
+        return C.Cells.IsValid() ? (*C.Cells)[(X & ChunkMask) + ((Y & ChunkMask) << ChunkShift)] : C.Uniform;
+    }
+
+    /** Read by flat index (X + Y*SizeX). Direct in flat mode; chunked mode splits the index. */
+    T operator[](int32 Index) const
+    {
+        return bChunked ? Get(Index % SizeX, Index / SizeX) : FlatData[Index];
+    }
+
+    void Set(int32 X, int32 Y, const T& Value)
+    {
+        if (!bChunked)
+        {
+            MutableFlatData()[X + Y * SizeX] = Value;
+            return;
+        }
+        FChunk& C = Chunks[(X >> ChunkShift) + (Y >> ChunkShift) * NumChunksX];
+        if (!C.Cells.IsValid())
+        {
+            if (C.Uniform == Value) return; // no-op write keeps the tile uniform
+            Detach(C.Cells, /*bKeepContents*/ false).Init(C.Uniform, ChunkCells);
+        }
+        Detach(C.Cells)[(X & ChunkMask) + ((Y & ChunkMask) << ChunkShift)] = Value;
+    }
+
+    void SetIndex(int32 Index, const T& Value)
+    {
+        if (bChunked) Set(Index % SizeX, Index / SizeX, Value);
+        else MutableFlatData()[Index] = Value;
+    }
+
+    /**
+     * Clone flat storage now if a copy shares it, so row pointers from GetRowData stay valid
+     * across later writes. Chunked planes read through Get() and need nothing.
+     */
+    void MakeUnique()
+    {
+        if (!bChunked && Data.IsValid()) MutableFlatData();
+    }
+
+    /** Collapse materialized tiles whose cells all hold the same value. Returns number of tiles released. */
+    int32 Compact()
+    {
+        int32 Released = 0;
+        if (!bChunked) return Released;
+        for (int32 cy = 0; cy < NumChunksY; ++cy)
+        for (int32 cx = 0; cx < NumChunksX; ++cx)
+        {
+            FChunk& C = Chunks[cx + cy * NumChunksX];
+            if (!C.Cells.IsValid()) continue;
+            const FCells& Cells = *C.Cells;
+            const FIntRect R = GetChunkRect(cx, cy);
+            const T First = Cells[(R.Min.X & ChunkMask) + ((R.Min.Y & ChunkMask) << ChunkShift)];
+            bool bUniform = true;
+            for (int32 y = R.Min.Y; y < R.Max.Y && bUniform; ++y)
+            for (int32 x = R.Min.X; x < R.Max.X; ++x)
+            {
+                if (!(Cells[(x & ChunkMask) + ((y & ChunkMask) << ChunkShift)] == First)) { bUniform = false; break; }
+            }
+            if (bUniform)
+            {
+                C.Uniform = First;
+                C.Cells.Reset(); // only drops our reference; copies sharing the tile keep it
+                ++Released;
+            }
+        }
+        return Released;
+    }
+
+    // Chunk-level queries. Flat planes report the same tile layout but never claim uniformity.
+
+    bool IsChunked() const { return bChunked; }
+    FIntPoint GetNumChunks() const { return FIntPoint(NumChunksX, NumChunksY); }
+
+    /** Cell rect of a tile, clipped to the map (Max exclusive). */
+    FIntRect GetChunkRect(int32 CX, int32 CY) const
+    {
+        const int32 X0 = CX << ChunkShift;
+        const int32 Y0 = CY << ChunkShift;
+        return FIntRect(X0, Y0, FMath::Min(X0 + ChunkSize, SizeX), FMath::Min(Y0 + ChunkSize, SizeY));
+    }
+
+    /** True if every cell of the tile is known to hold the same value (written to OutValue). */
+    bool IsChunkUniform(int32 CX, int32 CY, T& OutValue) const
+    {
+        if (!bChunked) return false;
+        const FChunk& C = Chunks[CX + CY * NumChunksX];
+        if (C.Cells.IsValid()) return false;
+        OutValue = C.Uniform;
+        return true;
+    }
+
+    /** Contiguous flat storage, or nullptr in chunked mode. */
+    const T* GetFlatData() const { return bChunked ? nullptr : FlatData; }
+
+    /** Start of row Y in flat storage, or nullptr in chunked mode. */
+    const T* GetRowData(int32 Y) const { return bChunked ? nullptr : FlatData + Y * SizeX; }
+
+    /** Number of materialized tiles (chunked) or 0 (flat). */
+    int32 GetNumMaterializedChunks() const
+    {
+        int32 Count = 0;
+        for (const FChunk& C : Chunks) if (C.Cells.IsValid()) ++Count;
+        return Count;
+    }
+
+    /**
+     * Save/load the plane as (run length, value) pairs in row-major order. The plane must already
+     * be Init()ed to the saved size when loading. Malformed runs flag the archive with SetError().
+     */
+    void SerializeRuns(FArchive& Ar)
+    {
+        const int32 NumCells = SizeX * SizeY;
+        if (Ar.IsSaving())
+        {
+            int32 i = 0;
+            while (i < NumCells)
+            {
+                T Value = (*this)[i];
+                int32 Run = 1;
+                while (i + Run < NumCells && (*this)[i + Run] == Value) ++Run;
+                Ar << Run;
+                Ar << Value;
+                i += Run;
+            }
+            return;
+        }
+
+        TArray<T> Flat;
+        Flat.SetNumUninitialized(NumCells);
+        int32 i = 0;
+        while (i < NumCells && !Ar.IsError())
+        {
+            int32 Run = 0;
+            T Value = T();
+            Ar << Run;
+            Ar << Value;
+            if (Run <= 0 || Run > NumCells - i)
+            {
+                Ar.SetError();
+                return;
+            }
+            for (int32 k = 0; k < Run; ++k) Flat[i + k] = Value;
+            i += Run;
+        }
+        if (!Ar.IsError()) Assign(Flat.GetData());
+    }
+
+    /** Bytes referenced by this plane, including arrays currently shared with copies. */
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Bytes = (Data.IsValid() ? Data->GetAllocatedSize() : 0) + Chunks.GetAllocatedSize();
+        for (const FChunk& C : Chunks) if (C.Cells.IsValid()) Bytes += C.Cells->GetAllocatedSize();
+        return Bytes;
+    }
+
+private:
+    struct FChunk
+    {
+        /** Value of every cell while Cells is null */
+        T Uniform = T();
+        /** Materialized cells (ChunkSize*ChunkSize, row-major in the tile), possibly shared with copies */
+        FCellsRef Cells;
+    };
+
+    /** Make Ref exclusively ours before writing, cloning it if a copy still shares it. */
+    static FCells& Detach(FCellsRef& Ref, bool bKeepContents = true)
+    {
+        if (!Ref.IsValid())
+        {
+            Ref = MakeShared<FCells, ESPMode::ThreadSafe>();
+        }
+        else if (!Ref.IsUnique())
+        {
+            Ref = bKeepContents ? MakeShared<FCells, ESPMode::ThreadSafe>(*Ref) : MakeShared<FCells, ESPMode::ThreadSafe>();
+        }
+        return *Ref;
+    }
+
+    T* MutableFlatData()
+    {
+        if (!Data.IsUnique())
+        {
+            FlatData = Detach(Data).GetData();
+        }
+        return FlatData;
+    }
+
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    int32 NumChunksX = 0;
+    int32 NumChunksY = 0;
+    bool bChunked = false;
+
+    /** Flat cells (flat mode) and a cached pointer to them for reads */
+    FCellsRef Data;
+    T* FlatData = nullptr;
+
+    TArray<FChunk> Chunks;
+};
+
+/**
+ * One bit per cell, packed into 64-bit words. Each row starts on a word boundary
+ * (WordsPerRow = ceil(SizeX/64)) so row spans can be updated word by word.
+ * Words are shared between copies and cloned on the first write (see TMapGridPlane).
+ */
+class FMapGridBitPlane
+{
+public:
+    void Init(int32 InSizeX, int32 InSizeY)
+    {
+        SizeX = FMath::Max(0, InSizeX);
+        SizeY = FMath::Max(0, InSizeY);
+        WordsPerRow = (SizeX + 63) >> 6;
+        if (!Words.IsValid() || !Words.IsUnique())
+        {
+            Words = MakeShared<TArray<uint64>, ESPMode::ThreadSafe>();
+        }
+        Words->Init(0, WordsPerRow * SizeY);
+        WordData = Words->GetData();
+    }
+
+    bool Get(int32 X, int32 Y) const
+    {
+        return (WordData[WordIndex(X, Y)] >> (X & 63)) & 1;
+    }
+
+    void Set(int32 X, int32 Y, bool bValue)
+    {
+        const uint64 Bit = uint64(1) << (X & 63);
+        uint64& Word = MutableWordData()[WordIndex(X, Y)];
+        Word = bValue ? (Word | Bit) : (Word & ~Bit);
+    }
+
+    /**
+     * Set bits [X0, X1] (inclusive, already clipped to the row) and call Visitor(X) for every
+     * bit that was clear before. Returns the number of newly set bits.
+     */
+    template<typename FuncType>
+    int32 SetSpan(int32 Y, int32 X0, int32 X1, FuncType&& Visitor)
+    {
+        int32 NumNew = 0;
+        uint64* Row = MutableWordData() + Y * WordsPerRow;
+        for (int32 w = X0 >> 6; w <= (X1 >> 6); ++w)
+        {
+            const int32 Lo = FMath::Max(X0, w << 6) & 63;
+            const int32 Hi = FMath::Min(X1, (w << 6) + 63) & 63;
+            const uint64 Mask = (~uint64(0) >> (63 - Hi)) & (~uint64(0) << Lo);
+            uint64 New = Mask & ~Row[w];
+            Row[w] |= Mask;
+            while (New)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(New));
+                Visitor((w << 6) + Bit);
+                New &= New - 1;
+                ++NumNew;
+            }
+        }
+        return NumNew;
+    }
+
+    /** Save/load the raw words. The plane must already be Init()ed to the saved size when loading. */
+    void Serialize(FArchive& Ar)
+    {
+        const int32 Expected = WordsPerRow * SizeY;
+        int32 Num = Expected;
+        Ar << Num;
+        if (Ar.IsLoading())
+        {
+            // Validate the stored count before touching memory; the plane keeps its Init()ed size
+            Init(SizeX, SizeY);
+            if (Num != Expected)
+            {
+                Ar.SetError();
+                return;
+            }
+        }
+        for (uint64& Word : *Words)
+        {
+            Ar << Word;
+        }
+        WordData = Words->GetData();
+    }
+
+    int32 GetWordsPerRow() const { return WordsPerRow; }
+    const TArray<uint64>& GetWords() const { return *Words; }
+    SIZE_T GetAllocatedSize() const { return Words.IsValid() ? Words->GetAllocatedSize() : 0; }
+
+private:
+    int32 WordIndex(int32 X, int32 Y) const { return (X >> 6) + Y * WordsPerRow; }
+
+    uint64* MutableWordData()
+    {
+        if (!Words.IsUnique())
+        {
+            Words = MakeShared<TArray<uint64>, ESPMode::ThreadSafe>(*Words);
+            WordData = Words->GetData();
+        }
+        return WordData;
+    }
+
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    int32 WordsPerRow = 0;
+    TSharedPtr<TArray<uint64>, ESPMode::ThreadSafe> Words;
+    uint64* WordData = nullptr;
+};
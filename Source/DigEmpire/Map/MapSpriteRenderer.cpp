@@ -405,26 +405,29 @@ void AMapSpriteRenderer::RebuildAllFromMap(UMapGrid2DComponent* InMapSource)
     ClearAll();
     EnsureAtlasHISM();
 
-    const FIntPoint Size = MapSource->GetSize();
+    const UMapGrid2D* Map = MapSource->GetMap();
+    const FIntPoint Size = Map->GetSize();
     FGridCellWithCoord Entry;
-    for (int32 y = 0; y < Size.Y; ++y)
+    // Only the planes the atlas draws are read (background, object, ore overlay); no per-cell FMapCell copy
+    constexpr uint32 Fields = EMapCellField::Background | EMapCellField::Object | EMapCellField::Durability | EMapCellField::Ore;
+    Map->ForEachCellInRect<Fields>(FIntRect(0, 0, Size.X, Size.Y), [&](const FMapCellView& V)
     {
-        for (int32 x = 0; x < Size.X; ++x)
-        {
-            Entry.Coord = FIntPoint(x, y);
-            if (!MapSource->GetCell(x, y, Entry.Cell)) continue;
+        Entry.Coord = FIntPoint(V.X, V.Y);
+        Entry.Cell.BackgroundTag = Map->GetTagById(V.BackgroundId);
+        Entry.Cell.ObjectTag = Map->GetTagById(V.ObjectId);
+        Entry.Cell.ObjectDurability = V.Durability;
+        Entry.Cell.OreTag = Map->GetTagById(V.OreId);
 
-            Atlas_AddOrUpdateBackground(Entry);
+        Atlas_AddOrUpdateBackground(Entry);
 
-            if (Entry.Cell.HasObject())
+        if (V.HasObject())
+        {
+            if (!InitialObjectDurability.Contains(Entry.Coord))
             {
-                if (!InitialObjectDurability.Contains(Entry.Coord))
-                {
-                    InitialObjectDurability.Add(Entry.Coord, Entry.Cell.ObjectDurability);
-                }
-
-                Atlas_AddOrUpdateObject(Entry);
+                InitialObjectDurability.Add(Entry.Coord, V.Durability);
             }
+
+            Atlas_AddOrUpdateObject(Entry);
         }
-    }
+    });
 }
@@ -1,13 +1,15 @@
 #include "RoomGenSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "DigEmpire/Map/Generation/MapGenerationContext.h"
 #include "RoomGenerator.h"
 // No longer depends on ZoneBorderSettings
 
-void URoomGenSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* /*World*/, TArray<int32>& InOutZoneLabels) const
+void URoomGenSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
-    if (InOutZoneLabels.Num() <= 0) return;
+    if (!Context.HasZoneLabels()) return;
     URoomGenerator* RoomGen = NewObject<URoomGenerator>();
-    RoomGen->Generate(Map, InOutZoneLabels, this);
+    RoomGen->Generate(Context, this);
 }
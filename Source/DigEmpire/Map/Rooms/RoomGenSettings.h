@@ -35,7 +35,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Rooms")
     TArray<FRoomSpec> Rooms;
 
-    /** Max random placement attempts per room (<=0 = deterministic full scan). */
+    /** > 0: each room takes a uniformly random valid position; <= 0: the first valid position in row-major order. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Random", meta=(ClampMin="-1"))
     int32 MaxPlacementAttempts = 512;
 
@@ -52,5 +52,8 @@ public:
     int32 RoomWallDurability = 100;
 
     // Execute step: run room generator
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Objects | EMapGenAccess::Passages; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::Objects | EMapGenAccess::Rooms; }
 };
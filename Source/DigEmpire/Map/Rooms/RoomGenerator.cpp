@@ -1,5 +1,6 @@
 #include "RoomGenerator.h"
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "DigEmpire/Map/Generation/MapGenerationContext.h"
 #include "RoomTypes.h"
 // No longer depends on ZoneBorderSettings
 
@@ -7,16 +8,39 @@ bool URoomGenerator::Generate(UMapGrid2D* MapGrid,
                               const TArray<int32>& ZoneLabels,
                               const URoomGenSettings* Settings)
 {
+    FMapGenerationContext Context(MapGrid, /*World*/ nullptr);
+    Context.SetZoneLabels(CopyTemp(ZoneLabels));
+    return Generate(Context, Settings);
+}
+
+bool URoomGenerator::Generate(FMapGenerationContext& Context, const URoomGenSettings* Settings)
+{
+    UMapGrid2D* MapGrid = Context.GetMap();
     if (!MapGrid || !Settings) return false;
     const FIntPoint Size = MapGrid->GetSize();
     const int32 W = Size.X, H = Size.Y;
     if (W <= 0 || H <= 0) return false;
+    const TArray<int32>& ZoneLabels = Context.GetZoneLabels();
     if (ZoneLabels.Num() != W * H) return false;
 
     FRandomStream RNG(Settings->RandomSeed);
     if (Settings->RandomSeed < 0) { RNG.GenerateNewSeed(); }
     const int32 MaxAttempts = Settings->MaxPlacementAttempts;
 
+    // Zone bounding boxes and passage cells, shared by every room spec
+    const TConstArrayView<FIntRect> ZoneBoxes = Context.GetZoneBounds();
+    const int32 MaxLabel = ZoneBoxes.Num() - 1;
+    auto ZoneBox = [&](int32 z) { return ZoneBoxes.IsValidIndex(z) ? ZoneBoxes[z] : FIntRect(); };
+
+    TBitArray<> PassageCells(false, W * H);
+    for (const FZonePassage& P : MapGrid->GetPassages())
+    {
+        for (const FIntPoint& C : P.Cells)
+        {
+            if (MapGrid->IsInBounds(C.X, C.Y)) PassageCells[Idx(C.X, C.Y, W)] = true;
+        }
+    }
+
     bool bAnyPlaced = false;
     const FGameplayTag WallTag = Settings->RoomWallObjectTag;
     const int32 WallHP = Settings->RoomWallDurability;
@@ -28,7 +52,6 @@ bool URoomGenerator::Generate(UMapGrid2D* MapGrid,
         if (TargetZone < 0)
         {
             // Build list of zones [0..MaxLabel] and shuffle
-            int32 MaxLabel = 0; for (int v : ZoneLabels) if (v > MaxLabel) MaxLabel = v;
             TArray<int32> Zones; Zones.Reserve(MaxLabel + 1);
             for (int32 z = 0; z <= MaxLabel; ++z) Zones.Add(z);
             for (int32 i = Zones.Num() - 1; i > 0; --i) { const int32 j = RNG.RandRange(0, i); Zones.Swap(i, j); }
@@ -36,13 +59,13 @@ bool URoomGenerator::Generate(UMapGrid2D* MapGrid,
             bool bPlaced = false;
             for (int32 z : Zones)
             {
-                bPlaced = TryPlaceRoomInZone(MapGrid, Size, z, Spec.Width, Spec.Height, ZoneLabels, WallTag, WallHP, MaxAttempts, RNG);
+                bPlaced = TryPlaceRoomInZone(MapGrid, Size, z, ZoneBox(z), PassageCells, Spec.Width, Spec.Height, ZoneLabels, WallTag, WallHP, MaxAttempts, RNG);
                 if (bPlaced) { bAnyPlaced = true; break; }
             }
             continue; // move to next room spec
         }
 
-        if (TryPlaceRoomInZone(MapGrid, Size, TargetZone, Spec.Width, Spec.Height, ZoneLabels, WallTag, WallHP, MaxAttempts, RNG))
+        if (TryPlaceRoomInZone(MapGrid, Size, TargetZone, ZoneBox(TargetZone), PassageCells, Spec.Width, Spec.Height, ZoneLabels, WallTag, WallHP, MaxAttempts, RNG))
         {
             bAnyPlaced = true;
         }
@@ -54,6 +77,8 @@ bool URoomGenerator::Generate(UMapGrid2D* MapGrid,
 bool URoomGenerator::TryPlaceRoomInZone(UMapGrid2D* Map,
                                         const FIntPoint& Size,
                                         int32 ZoneId,
+                                        const FIntRect& ZoneBox,
+                                        const TBitArray<>& PassageCells,
                                         int32 RoomW,
                                         int32 RoomH,
                                         const TArray<int32>& Labels,
@@ -64,207 +89,158 @@ bool URoomGenerator::TryPlaceRoomInZone(UMapGrid2D* Map,
 {
     const int32 W = Size.X, H = Size.Y;
     if (RoomW <= 0 || RoomH <= 0 || RoomW > W || RoomH > H) return false;
-    // Build a quick lookup of passage cells belonging to this zone
-    TSet<FIntPoint> ZonePassageCells;
-    for (const FZonePassage& P : Map->GetPassages())
+    if (RoomW < 3 && RoomH < 3) return false; // no non-corner border cell for the entrance
+    if (ZoneBox.IsEmpty()) return false;      // zone has no cells
+
+    // Origins keeping the room inside the zone bounds and its 1-cell clearance ring inside the map
+    const int32 MinX0 = FMath::Max(1, ZoneBox.Min.X), MaxX0 = FMath::Min(W - 1, ZoneBox.Max.X) - RoomW;
+    const int32 MinY0 = FMath::Max(1, ZoneBox.Min.Y), MaxY0 = FMath::Min(H - 1, ZoneBox.Max.Y) - RoomH;
+    if (MinX0 > MaxX0 || MinY0 > MaxY0) return false;
+
+    // Integral images over the zone bounds plus the clearance ring:
+    //  - Objects: cells with a wall/object (room and ring must have none)
+    //  - Unusable: cells of other zones or passage cells (room interior must have none)
+    const FIntRect Grid(FMath::Max(0, ZoneBox.Min.X - 1), FMath::Max(0, ZoneBox.Min.Y - 1),
+                        FMath::Min(W, ZoneBox.Max.X + 1), FMath::Min(H, ZoneBox.Max.Y + 1));
+    const int32 SW = Grid.Width() + 1;
+    TArray<int32> Objects, Unusable;
+    Objects.SetNumZeroed(SW * (Grid.Height() + 1));
+    Unusable.SetNumZeroed(SW * (Grid.Height() + 1));
+
+    auto SatIdx = [&](int32 X, int32 Y) { return (X - Grid.Min.X) + (Y - Grid.Min.Y) * SW; };
+    Map->ForEachCellInRect<EMapCellField::Object | EMapCellField::Durability>(Grid, [&](const FMapCellView& V)
     {
-        for (const FIntPoint& C : P.Cells)
+        // Row-major visit: the entries above and to the left are already summed
+        const int32 gid = Idx(V.X, V.Y, W);
+        const int32 s = SatIdx(V.X + 1, V.Y + 1);
+        const int32 Up = SatIdx(V.X + 1, V.Y), Left = SatIdx(V.X, V.Y + 1), Diag = SatIdx(V.X, V.Y);
+        Objects[s] = (V.HasObject() ? 1 : 0) + Objects[Up] + Objects[Left] - Objects[Diag];
+        Unusable[s] = (Labels[gid] != ZoneId || PassageCells[gid] ? 1 : 0) + Unusable[Up] + Unusable[Left] - Unusable[Diag];
+    });
+
+    // Cells in [X0,X1) x [Y0,Y1)
+    auto RectSum = [&](const TArray<int32>& Sat, int32 X0, int32 Y0, int32 X1, int32 Y1)
+    {
+        return Sat[SatIdx(X1, Y1)] - Sat[SatIdx(X0, Y1)] - Sat[SatIdx(X1, Y0)] + Sat[SatIdx(X0, Y0)];
+    };
+
+    // Every valid origin, each tested in O(1)
+    TArray<FIntPoint> Valid;
+    for (int32 y0 = MinY0; y0 <= MaxY0; ++y0)
+    {
+        for (int32 x0 = MinX0; x0 <= MaxX0; ++x0)
         {
-            const int id = Idx(C.X, C.Y, W);
-            if (id < 0 || id >= W*H) continue;
-            if (Labels[id] == ZoneId) ZonePassageCells.Add(C);
+            if (RectSum(Unusable, x0, y0, x0 + RoomW, y0 + RoomH) != 0) continue;
+            if (RectSum(Objects, x0 - 1, y0 - 1, x0 + RoomW + 1, y0 + RoomH + 1) != 0) continue;
+            Valid.Add(FIntPoint(x0, y0));
         }
     }
-    auto TryAt = [&](int32 x0, int32 y0)->bool
-    {
-            bool bFits = true;
-            for (int32 dy = 0; dy < RoomH && bFits; ++dy)
-            {
-                for (int32 dx = 0; dx < RoomW; ++dx)
-                {
-                    const int32 x = x0 + dx;
-                    const int32 y = y0 + dy;
-                    const int32 id = Idx(x, y, W);
-                    if (Labels[id] != ZoneId)
-                    {
-                        bFits = false; break;
-                    }
-                    // Also ensure there is no wall/object currently.
-                    int32 DummyDur = 0; FGameplayTag DummyTag;
-                    if (Map->GetObjectAt(x, y, DummyTag, DummyDur))
-                    {
-                        bFits = false; break;
-                    }
-                    // Do not overlap passage cells with the room interior
-                    if (ZonePassageCells.Contains(FIntPoint(x, y)))
-                    {
-                        bFits = false; break;
-                    }
-                }
-            }
-            if (!bFits) return false;
-
-            // Ensure a 1-cell free corridor around the room: all outside-neighboring cells must be in-bounds and empty.
-            if (!(x0 > 0 && y0 > 0 && (x0 + RoomW) < W && (y0 + RoomH) < H))
-            {
-                return false; // no clearance at map edge
-            }
-
-            auto IsFree = [&](int32 cx, int32 cy)->bool
-            {
-                FGameplayTag T; int32 D = 0;
-                return !Map->GetObjectAt(cx, cy, T, D);
-            };
-
-            const int32 xOutMin = x0 - 1;
-            const int32 xOutMax = x0 + RoomW;
-            const int32 yOutMin = y0 - 1;
-            const int32 yOutMax = y0 + RoomH;
-
-            bool bClearRing = true;
-            // Top and bottom outside rows (including corners)
-            for (int32 x = xOutMin; x <= xOutMax && bClearRing; ++x)
-            {
-                if (!Map->IsInBounds(x, yOutMin) || !IsFree(x, yOutMin)) { bClearRing = false; break; }
-                if (!Map->IsInBounds(x, yOutMax) || !IsFree(x, yOutMax)) { bClearRing = false; break; }
-            }
-            // Left and right outside columns
-            for (int32 y = y0; y < y0 + RoomH && bClearRing; ++y)
-            {
-                if (!Map->IsInBounds(xOutMin, y) || !IsFree(xOutMin, y)) { bClearRing = false; break; }
-                if (!Map->IsInBounds(xOutMax, y) || !IsFree(xOutMax, y)) { bClearRing = false; break; }
-            }
+    if (Valid.Num() == 0) return false;
 
-            if (!bClearRing) return false;
-
-            // Ensure the room border (where walls would be placed) does not overlap passage cells
-            // Top and bottom edges
-            for (int32 dx = 0; dx < RoomW; ++dx)
-            {
-                if (ZonePassageCells.Contains(FIntPoint(x0 + dx, y0))) return false;
-                if (ZonePassageCells.Contains(FIntPoint(x0 + dx, y0 + RoomH - 1))) return false;
-            }
-            // Left and right edges (skip corners)
-            for (int32 dy = 1; dy < RoomH - 1; ++dy)
-            {
-                if (ZonePassageCells.Contains(FIntPoint(x0, y0 + dy))) return false;
-                if (ZonePassageCells.Contains(FIntPoint(x0 + RoomW - 1, y0 + dy))) return false;
-            }
-
-            // Choose a single entrance on the room border such that outside cell is not a wall/object.
-            int32 entranceX = -1, entranceY = -1;
-            auto IsOutsideFree = [&](int32 ox, int32 oy) -> bool
-            {
-                if (!Map->IsInBounds(ox, oy)) return false;
-                FGameplayTag T; int32 D = 0;
-                return !Map->GetObjectAt(ox, oy, T, D);
-            };
-
-            // Build a list of candidate entrance cells along the border where the outside cell is free.
-            TArray<FIntPoint> Candidates;
-            // Top edge (north) — skip corners
-            for (int32 dx = 1; dx < RoomW - 1; ++dx)
-            {
-                const int32 x = x0 + dx; const int32 y = y0;
-                if (IsOutsideFree(x, y - 1)) Candidates.Add(FIntPoint(x, y));
-            }
-            // Bottom edge (south) — skip corners
-            for (int32 dx = 1; dx < RoomW - 1; ++dx)
-            {
-                const int32 x = x0 + dx; const int32 y = y0 + RoomH - 1;
-                if (IsOutsideFree(x, y + 1)) Candidates.Add(FIntPoint(x, y));
-            }
-            // Left edge (west) — skip corners
-            for (int32 dy = 1; dy < RoomH - 1; ++dy)
-            {
-                const int32 x = x0; const int32 y = y0 + dy;
-                if (IsOutsideFree(x - 1, y)) Candidates.Add(FIntPoint(x, y));
-            }
-            // Right edge (east) — skip corners
-            for (int32 dy = 1; dy < RoomH - 1; ++dy)
-            {
-                const int32 x = x0 + RoomW - 1; const int32 y = y0 + dy;
-                if (IsOutsideFree(x + 1, y)) Candidates.Add(FIntPoint(x, y));
-            }
-
-            if (Candidates.Num() > 0)
-            {
-                const int32 idx = RNG.RandRange(0, Candidates.Num() - 1);
-                entranceX = Candidates[idx].X;
-                entranceY = Candidates[idx].Y;
-            }
+    // Random: uniform over valid origins; deterministic: first one in row-major order
+    const FIntPoint Origin = (MaxAttempts > 0) ? Valid[RNG.RandRange(0, Valid.Num() - 1)] : Valid[0];
+    return BuildRoomAt(Map, ZoneId, Origin.X, Origin.Y, RoomW, RoomH, WallTag, WallHP, RNG);
+}
 
-            // If no valid entrance found, skip this placement.
-            if (entranceX < 0) return false;
+bool URoomGenerator::BuildRoomAt(UMapGrid2D* Map,
+                                 int32 ZoneId,
+                                 int32 x0,
+                                 int32 y0,
+                                 int32 RoomW,
+                                 int32 RoomH,
+                                 const FGameplayTag& WallTag,
+                                 int32 WallHP,
+                                 FRandomStream& RNG)
+{
+    // Choose a single entrance on the room border such that outside cell is not a wall/object.
+    int32 entranceX = -1, entranceY = -1;
+    auto IsOutsideFree = [&](int32 ox, int32 oy) -> bool
+    {
+        if (!Map->IsInBounds(ox, oy)) return false;
+        return !Map->HasObjectAt(ox, oy);
+    };
 
-            // Build walls along the rectangle border, skipping the entrance cell.
+    // Build a list of candidate entrance cells along the border where the outside cell is free.
+    TArray<FIntPoint> Candidates;
+    // Top edge (north) — skip corners
+    for (int32 dx = 1; dx < RoomW - 1; ++dx)
+    {
+        const int32 x = x0 + dx; const int32 y = y0;
+        if (IsOutsideFree(x, y - 1)) Candidates.Add(FIntPoint(x, y));
+    }
+    // Bottom edge (south) — skip corners
+    for (int32 dx = 1; dx < RoomW - 1; ++dx)
+    {
+        const int32 x = x0 + dx; const int32 y = y0 + RoomH - 1;
+        if (IsOutsideFree(x, y + 1)) Candidates.Add(FIntPoint(x, y));
+    }
+    // Left edge (west) — skip corners
+    for (int32 dy = 1; dy < RoomH - 1; ++dy)
+    {
+        const int32 x = x0; const int32 y = y0 + dy;
+        if (IsOutsideFree(x - 1, y)) Candidates.Add(FIntPoint(x, y));
+    }
+    // Right edge (east) — skip corners
+    for (int32 dy = 1; dy < RoomH - 1; ++dy)
+    {
+        const int32 x = x0 + RoomW - 1; const int32 y = y0 + dy;
+        if (IsOutsideFree(x + 1, y)) Candidates.Add(FIntPoint(x, y));
+    }
 
-            // Top and bottom rows
-            for (int32 dx = 0; dx < RoomW; ++dx)
-            {
-                const int32 xt = x0 + dx;
-                const int32 yt = y0;
-                const int32 xb = x0 + dx;
-                const int32 yb = y0 + RoomH - 1;
-                // Top
-                if (!(xt == entranceX && yt == entranceY))
-                {
-                    Map->AddOrUpdateObjectAt(xt, yt, WallTag, WallHP);
-                }
-                // Bottom
-                if (!(xb == entranceX && yb == entranceY))
-                {
-                    Map->AddOrUpdateObjectAt(xb, yb, WallTag, WallHP);
-                }
-            }
+    if (Candidates.Num() > 0)
+    {
+        const int32 idx = RNG.RandRange(0, Candidates.Num() - 1);
+        entranceX = Candidates[idx].X;
+        entranceY = Candidates[idx].Y;
+    }
 
-            // Left and right columns (skip corners which were set above)
-            for (int32 dy = 1; dy < RoomH - 1; ++dy)
-            {
-                const int32 xl = x0;
-                const int32 yl = y0 + dy;
-                const int32 xr = x0 + RoomW - 1;
-                const int32 yr = y0 + dy;
-                if (!(xl == entranceX && yl == entranceY))
-                {
-                    Map->AddOrUpdateObjectAt(xl, yl, WallTag, WallHP);
-                }
-                if (!(xr == entranceX && yr == entranceY))
-                {
-                    Map->AddOrUpdateObjectAt(xr, yr, WallTag, WallHP);
-                }
-            }
+    // If no valid entrance found, skip this placement.
+    if (entranceX < 0) return false;
 
-            // Success placing this room: record room info on the map
-            FRoomInfo Info;
-            Info.ZoneId = ZoneId;
-            Info.TopLeft = FIntPoint(x0, y0);
-            Info.Size = FIntPoint(RoomW, RoomH);
-            Info.Entrance = FIntPoint(entranceX, entranceY);
-            Map->AddRoom(Info);
-            return true;
-    };
+    // Build walls along the rectangle border, skipping the entrance cell.
 
-    if (MaxAttempts > 0)
+    // Top and bottom rows
+    for (int32 dx = 0; dx < RoomW; ++dx)
     {
-        for (int32 attempt = 0; attempt < MaxAttempts; ++attempt)
+        const int32 xt = x0 + dx;
+        const int32 yt = y0;
+        const int32 xb = x0 + dx;
+        const int32 yb = y0 + RoomH - 1;
+        // Top
+        if (!(xt == entranceX && yt == entranceY))
+        {
+            Map->AddOrUpdateObjectAt(xt, yt, WallTag, WallHP);
+        }
+        // Bottom
+        if (!(xb == entranceX && yb == entranceY))
         {
-            const int32 x0 = RNG.RandRange(0, W - RoomW);
-            const int32 y0 = RNG.RandRange(0, H - RoomH);
-            if (TryAt(x0, y0)) return true;
+            Map->AddOrUpdateObjectAt(xb, yb, WallTag, WallHP);
         }
-        return false;
     }
-    else
+
+    // Left and right columns (skip corners which were set above)
+    for (int32 dy = 1; dy < RoomH - 1; ++dy)
     {
-        // Deterministic full scan
-        for (int32 y0 = 0; y0 <= H - RoomH; ++y0)
+        const int32 xl = x0;
+        const int32 yl = y0 + dy;
+        const int32 xr = x0 + RoomW - 1;
+        const int32 yr = y0 + dy;
+        if (!(xl == entranceX && yl == entranceY))
         {
-            for (int32 x0 = 0; x0 <= W - RoomW; ++x0)
-            {
-                if (TryAt(x0, y0)) return true;
-            }
+            Map->AddOrUpdateObjectAt(xl, yl, WallTag, WallHP);
+        }
+        if (!(xr == entranceX && yr == entranceY))
+        {
+            Map->AddOrUpdateObjectAt(xr, yr, WallTag, WallHP);
         }
-        return false;
     }
+
+    // Success placing this room: record room info on the map
+    FRoomInfo Info;
+    Info.ZoneId = ZoneId;
+    Info.TopLeft = FIntPoint(x0, y0);
+    Info.Size = FIntPoint(RoomW, RoomH);
+    Info.Entrance = FIntPoint(entranceX, entranceY);
+    Map->AddRoom(Info);
+    return true;
 }
@@ -6,6 +6,7 @@
 #include "RoomGenerator.generated.h"
 
 class UMapGrid2D;
+class FMapGenerationContext;
 
 /** Places rectangular rooms inside zones and builds walls around them, leaving a single entrance. */
 UCLASS(BlueprintType)
@@ -22,11 +23,22 @@ public:
                   const TArray<int32>& ZoneLabels,
                   const URoomGenSettings* Settings);
 
+    /** Same against a step context, whose zone bounds are shared with the other steps. */
+    bool Generate(FMapGenerationContext& Context, const URoomGenSettings* Settings);
+
 private:
     static int32 Idx(int32 X, int32 Y, int32 W) { return X + Y * W; }
+
+    /**
+     * Place one RoomW x RoomH room in ZoneId. Valid origins (room inside the zone, off passages,
+     * free of objects together with a 1-cell clearance ring) are found with integral images.
+     * MaxAttempts > 0 picks uniformly among them, otherwise the first in row-major order.
+     */
     bool TryPlaceRoomInZone(UMapGrid2D* Map,
                             const FIntPoint& Size,
                             int32 ZoneId,
+                            const FIntRect& ZoneBox,
+                            const TBitArray<>& PassageCells,
                             int32 RoomW,
                             int32 RoomH,
                             const TArray<int32>& Labels,
@@ -34,4 +46,15 @@ private:
                             int32 WallHP,
                             int32 MaxAttempts,
                             FRandomStream& RNG);
+
+    /** Pick the entrance, build the walls and record the room. Origin must be valid. */
+    bool BuildRoomAt(UMapGrid2D* Map,
+                     int32 ZoneId,
+                     int32 x0,
+                     int32 y0,
+                     int32 RoomW,
+                     int32 RoomH,
+                     const FGameplayTag& WallTag,
+                     int32 WallHP,
+                     FRandomStream& RNG);
 };
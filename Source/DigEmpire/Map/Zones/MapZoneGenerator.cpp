@@ -2,9 +2,59 @@
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "Containers/Queue.h"
-#include "Algo/RandomShuffle.h"
 #include "DigEmpire/Map/MapGrid2D.h"
 
+namespace
+{
+	/** Sum tree over per-zone pick weights: O(log Z) update of one zone, O(log Z) weighted sample. */
+	class FZoneWeightTree
+	{
+	public:
+		void Init(int32 NumZones)
+		{
+			Leaves = 1;
+			while (Leaves < NumZones) Leaves <<= 1;
+			Nodes.Init(0.0, Leaves * 2);
+		}
+
+		void Set(int32 Zone, double Weight)
+		{
+			int32 Node = Leaves + Zone;
+			Nodes[Node] = Weight;
+			for (Node >>= 1; Node >= 1; Node >>= 1)
+			{
+				Nodes[Node] = Nodes[2 * Node] + Nodes[2 * Node + 1];
+			}
+		}
+
+		double GetTotal() const { return Nodes[1]; }
+
+		/** Zone whose cumulative weight range contains Pick (0 <= Pick < total). */
+		int32 Sample(double Pick) const
+		{
+			int32 Node = 1;
+			while (Node < Leaves)
+			{
+				const int32 Left = 2 * Node;
+				if (Pick < Nodes[Left] || Nodes[Left + 1] <= 0.0)
+				{
+					Node = Left;
+				}
+				else
+				{
+					Pick -= Nodes[Left];
+					Node = Left + 1;
+				}
+			}
+			return Node - Leaves;
+		}
+
+	private:
+		int32 Leaves = 1;
+		TArray<double> Nodes;
+	};
+}
+
 bool UMapZoneGenerator::Generate(UMapGrid2D* MapGrid,
                                  const UZoneGenSettings* Settings,
                                  UWorld* WorldForDebugDraw,
@@ -32,8 +82,12 @@ bool UMapZoneGenerator::Generate(UMapGrid2D* MapGrid,
 	OutZoneLabels.Init(-1, NumCells);
 
 	// Initialize frontiers and area counters
-	TArray<TArray<FFrontierEntry>> Frontiers;
+	TArray<FZoneFrontier> Frontiers;
 	Frontiers.SetNum(NumZones);
+	for (FZoneFrontier& F : Frontiers)
+	{
+		F.InFrontier.Init(false, NumCells);
+	}
 
 	TArray<int32> Area; Area.Init(0, NumZones);
 
@@ -72,26 +126,30 @@ bool UMapZoneGenerator::Generate(UMapGrid2D* MapGrid,
 
 	const float Epsilon = 0.0001f;
 
-	while (Unassigned > 0)
+	// Pick weight of a zone: remaining quota plus softness; zero if it cannot grow
+	auto ZoneWeight = [&](int32 z) -> double
 	{
-		// Build pick weights per zone
-		TArray<float> Weights; Weights.Init(0.f, NumZones);
-		float TotalW = 0.f;
+		if (Frontiers[z].Cells.Num() == 0) return 0.0;
 
-		for (int32 z = 0; z < NumZones; ++z)
-		{
-			auto& Frontier = Frontiers[z];
-			if (Frontier.Num() == 0) { Weights[z] = 0.f; continue; }
+		const bool bOverfilled = Area[z] >= int32(float(Targets[z]) * Settings->OverfillFactor);
+		if (bOverfilled) return 0.0;
 
-			const bool bOverfilled = Area[z] >= int32(float(Targets[z]) * Settings->OverfillFactor);
-			if (bOverfilled) { Weights[z] = 0.f; continue; }
+		const int32 Need = FMath::Max(0, Targets[z] - Area[z]);
+		return FMath::Max(Epsilon, float(Need)) + Settings->SoftnessK;
+	};
 
-			const int32 Need = FMath::Max(0, Targets[z] - Area[z]);
-			const float w = FMath::Max(Epsilon, float(Need)) + Settings->SoftnessK;
-			Weights[z] = w; TotalW += w;
-		}
+	// Only the zone that was sampled changes per iteration, so only its leaf is updated
+	FZoneWeightTree WeightTree;
+	WeightTree.Init(NumZones);
+	for (int32 z = 0; z < NumZones; ++z)
+	{
+		WeightTree.Set(z, ZoneWeight(z));
+	}
 
-		if (TotalW <= 0.f)
+	while (Unassigned > 0)
+	{
+		const double TotalW = WeightTree.GetTotal();
+		if (TotalW <= 0.0)
 		{
 			// Fallback: greedily assign remaining cells to nearest allowed zone  (simple flood from all zones)
 			// We perform a final multi-source fill without quotas but respecting constraints.
@@ -113,51 +171,30 @@ bool UMapZoneGenerator::Generate(UMapGrid2D* MapGrid,
 			break;
 		}
 
-		// Roulette-wheel sample a zone
-		const float Pick = RNG.FRandRange(0.f, TotalW);
-		float Acc = 0.f; int32 Z = 0;
-		for (; Z < NumZones; ++Z) { Acc += Weights[Z]; if (Pick <= Acc) break; }
-		if (Z >= NumZones) Z = NumZones - 1;
+		// Weighted sample of a zone (non-zero weight implies a non-empty frontier)
+		const int32 Z = WeightTree.Sample(RNG.FRand() * TotalW);
+		FZoneFrontier& Frontier = Frontiers[Z];
 
-		// Try several candidates from Z's frontier
-		auto& Frontier = Frontiers[Z];
-		if (Frontier.Num() == 0) continue;
+		// Random pop; uniform over the frontier, so its order does not matter
+		const int32 cid = Frontier.RemoveAt(RNG.RandRange(0, Frontier.Cells.Num() - 1));
+		const int32 CX = cid % W, CY = cid / W;
 
-		// Random pop
-		const int32 idxPop = RNG.RandRange(0, Frontier.Num() - 1);
-		const FFrontierEntry C = Frontier[idxPop];
-		Frontier.RemoveAtSwap(idxPop, 1, EAllowShrinking::No);
+		// Claimed by another zone since it was added, or rejected by a constraint: drop it.
+		// It can be re-added later when another neighbor of it is claimed.
+		const bool bClaim = OutZoneLabels[cid] == -1
+			&& !ViolatesForbiddenAdjacency(Z, CX, CY, Size, OutZoneLabels, ForbiddenFrom0Set)
+			&& !WithinMoatForbidden(Z, CX, CY, Size, DistFromZone0, Settings, ForbiddenFrom0Set);
 
-		// Already taken?
-		const int32 cid = Idx(C.X, C.Y, W);
-		if (OutZoneLabels[cid] != -1) continue;
-
-		// Constraint checks
-		if (ViolatesForbiddenAdjacency(Z, C.X, C.Y, Size, OutZoneLabels, ForbiddenFrom0Set))
-		{
-			continue;
-		}
-		if (WithinMoatForbidden(Z, C.X, C.Y, Size, DistFromZone0, Settings, ForbiddenFrom0Set))
+		if (bClaim)
 		{
-			continue;
-		}
-
-		// Claim
-		OutZoneLabels[cid] = Z;
-		Area[Z]++; Unassigned--;
+			OutZoneLabels[cid] = Z;
+			Area[Z]++; Unassigned--;
 
-		// Add neighbors to frontier
-		PushFreeNeighborsToFrontier(C.X, C.Y, Size, OutZoneLabels, Frontiers[Z]);
-
-		// Optional: slight bias for compactness — shuffle occasionally
-		if ((Area[Z] & 15) == 0 && Frontier.Num() > 1)
-		{
-			for (int32 i = Frontier.Num() - 1; i > 0; --i)
-			{
-				const int32 j = RNG.RandRange(0, i);
-				Frontier.Swap(i, j);
-			}
+			// Add neighbors to frontier
+			PushFreeNeighborsToFrontier(CX, CY, Size, OutZoneLabels, Frontier);
 		}
+
+		WeightTree.Set(Z, ZoneWeight(Z));
 	}
 
 	// Debug draw (optional)
@@ -302,16 +339,17 @@ bool UMapZoneGenerator::WithinMoatForbidden(int32 ClaimZone, int32 X, int32 Y,
 void UMapZoneGenerator::PushFreeNeighborsToFrontier(int32 X, int32 Y,
                                                     const FIntPoint& Size,
                                                     const TArray<int32>& Labels,
-                                                    TArray<FFrontierEntry>& Frontier) const
+                                                    FZoneFrontier& Frontier) const
 {
 	const int32 W = Size.X;
 
 	auto TryPush = [&](int32 nx, int32 ny)
 	{
 		if (nx < 0 || ny < 0 || nx >= Size.X || ny >= Size.Y) return;
-		if (Labels[Idx(nx,ny,W)] == -1)
+		const int32 id = Idx(nx,ny,W);
+		if (Labels[id] == -1)
 		{
-			Frontier.Add({nx,ny});
+			Frontier.Add(id);
 		}
 	};
 
@@ -34,7 +34,28 @@ public:
 
 private:
 	struct FSeed { int32 X=0, Y=0, Zone=0; };
-	struct FFrontierEntry { int32 X=0, Y=0; };
+
+	/** Unordered set of candidate cells for one zone: O(1) add (deduplicated), O(1) random removal. */
+	struct FZoneFrontier
+	{
+		TArray<int32> Cells;     // cell indices
+		TBitArray<> InFrontier;  // per map cell: already in Cells
+
+		void Add(int32 Cell)
+		{
+			if (InFrontier[Cell]) return;
+			InFrontier[Cell] = true;
+			Cells.Add(Cell);
+		}
+
+		int32 RemoveAt(int32 Slot)
+		{
+			const int32 Cell = Cells[Slot];
+			Cells.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+			InFrontier[Cell] = false;
+			return Cell;
+		}
+	};
 
 	// Internal helpers
 	bool ValidateInputs(UMapGrid2D* Map, const UZoneGenSettings* Settings) const;
@@ -56,7 +77,7 @@ private:
 	void PushFreeNeighborsToFrontier(int32 X, int32 Y,
 	                                 const FIntPoint& Size,
 	                                 const TArray<int32>& Labels,
-	                                 TArray<FFrontierEntry>& Frontier) const;
+	                                 FZoneFrontier& Frontier) const;
 
 	void ComputeDistFromZone0(const FIntPoint& Size,
 	                          const TArray<int32>& Labels,
@@ -1,16 +1,23 @@
 #include "ZoneGenSettings.h"
 
 #include "DigEmpire/Map/MapGrid2D.h"
+#include "DigEmpire/Map/Generation/MapGenerationContext.h"
 #include "MapZoneGenerator.h"
 
-void UZoneGenSettings::ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const
+void UZoneGenSettings::ExecuteGenerationStep(FMapGenerationContext& Context) const
 {
+    UMapGrid2D* Map = Context.GetMap();
     if (!Map) return;
     UMapZoneGenerator* Gen = NewObject<UMapZoneGenerator>();
-    InOutZoneLabels.Reset();
-    if (Gen->Generate(Map, this, World, InOutZoneLabels))
+    TArray<int32> Labels;
+    if (Gen->Generate(Map, this, Context.GetWorld(), Labels))
     {
-        Map->ApplyZoneLabels(InOutZoneLabels);
+        Map->ApplyZoneLabels(Labels);
+        Context.SetZoneLabels(MoveTemp(Labels));
+    }
+    else
+    {
+        Context.ResetZoneLabels();
     }
 }
 
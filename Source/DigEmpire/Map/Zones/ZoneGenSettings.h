@@ -80,5 +80,8 @@ public:
     float DebugZOffset = 10.f;
 
     // Execute step: run the zone generator and fill labels
-    virtual void ExecuteGenerationStep(UMapGrid2D* Map, UWorld* World, TArray<int32>& InOutZoneLabels) const override;
+    virtual void ExecuteGenerationStep(FMapGenerationContext& Context) const override;
+
+    virtual uint32 GetReadAccess() const override { return EMapGenAccess::None; }
+    virtual uint32 GetWriteAccess() const override { return EMapGenAccess::ZoneLabels | EMapGenAccess::Zones; }
 };
@@ -4,4 +4,5 @@
 UE_DEFINE_GAMEPLAY_TAG(TAG_Character_Vision, "Gameplay.Character.Vision");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Character_Vision_FirstSeen, "Gameplay.Character.Vision.FirstSeen");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Map_CellsUpdated, "Gameplay.Map.CellsUpdated");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Map_GenerationProgress, "Gameplay.Map.GenerationProgress");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Render_LuminanceUpdate, "Gameplay.Render.LuminanceUpdate");
@@ -14,5 +14,8 @@ UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Character_Vision_FirstSeen);
 // Map cells updated (object/background changes)
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Map_CellsUpdated);
 
+// Async map generation progress
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Map_GenerationProgress);
+
 // Luminance updates for visible cells
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Render_LuminanceUpdate);